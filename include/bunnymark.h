@@ -0,0 +1,9 @@
+#ifndef BUNNYMARK_H
+#define BUNNYMARK_H
+
+// Benchmark estilo bunnymark con wabbit_alpha.png: sube el numero de sprites
+// mientras el frame quepa en 1/60 s, primero con DrawTexture por sprite y
+// despues con el atlas + SpriteBatch. Se lanza con --bunnymark
+int RunBunnymark(void);
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef FRAME_PACING_H
+#define FRAME_PACING_H
+
+#include "raylib.h"
+
+// Parametros del control de resolucion dinamica (config.ini)
+typedef struct {
+    bool enabled;           // dynres=1
+    float targetFps;        // targetfps=60
+    float minScale;         // minscale=0.5
+    float maxScale;         // maxscale=1.0
+} PacingConfig;
+
+// -----------------------------------------------------------------------------
+// Resolucion dinamica: el pase 3D se dibuja en un RenderTexture2D a escala
+// y se estira a pantalla. La escala se ajusta cada frame segun el tiempo de
+// render medido respecto al presupuesto (1000 / targetFps ms). El resto (UI,
+// marca de agua, Lua) se sigue dibujando a resolucion nativa.
+//
+// Se usa el tiempo de render y no el de frame: el frame incluye la espera al
+// hilo de simulacion, y bajar la resolucion no acelera un frame lento por
+// simulacion.
+//
+// La textura se reserva una vez a maxScale y solo cambia el viewport, asi
+// que cambiar de escala no cuesta nada.
+// -----------------------------------------------------------------------------
+class FramePacer {
+public:
+    void Init(const PacingConfig& pacingConfig);
+    void Unload();
+
+    // Entre BeginDrawing y EndDrawing, rodeando el BeginMode3D/EndMode3D
+    void Begin3D();
+    void End3D();
+
+    // Una vez por frame con el tiempo real de render, de BeginDrawing hasta
+    // despues de EndDrawing (el intercambio de buffers espera a la GPU)
+    void Update(float renderTime);
+
+    float GetScale() const { return scale; }
+    float GetAverageRenderMs() const { return averageMs; }
+
+private:
+    void Allocate(int width, int height);
+
+    PacingConfig config = { false, 60.0f, 0.5f, 1.0f };
+    RenderTexture2D target = { 0 };
+    int nativeWidth = 0;
+    int nativeHeight = 0;
+    int viewWidth = 0;
+    int viewHeight = 0;
+    float scale = 1.0f;
+    float averageMs = 0.0f;
+    int cooldown = 0;
+    int stableFrames = 0;
+};
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef FRAME_PIPELINE_H
+#define FRAME_PIPELINE_H
+
+#include "raylib.h"
+#include "input_recorder.h"
+#include "particle_system.h"
+#include "scene_index.h"
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Comandos 2D grabados por Lua durante la simulacion y reproducidos en el
+// render, en el mismo orden
+// -----------------------------------------------------------------------------
+typedef enum {
+    LUA_DRAW_CLEAR,
+    LUA_DRAW_CIRCLE,
+    LUA_DRAW_RECT,
+    LUA_DRAW_LINE
+} LuaDrawType;
+
+typedef struct {
+    LuaDrawType type;
+    float values[4];
+    Color color;
+} LuaDrawCommand;
+
+// Destino de los comandos del hilo actual; con NULL se dibuja directamente
+void SetLuaDrawTarget(std::vector<LuaDrawCommand>* target);
+void LuaRecordClear(Color color);
+void LuaRecordCircle(int centerX, int centerY, float radius, Color color);
+void LuaRecordRect(int posX, int posY, int width, int height, Color color);
+void LuaRecordLine(int startX, int startY, int endX, int endY, Color color);
+void DrawLuaCommands(const std::vector<LuaDrawCommand>& commands);
+
+// Lo que la simulacion necesita del hilo principal para un frame
+typedef struct {
+    InputFrame input;
+    int screenWidth;
+    int screenHeight;
+} SimulationInput;
+
+// Resultado inmutable de simular un frame: todo lo que el render necesita
+typedef struct {
+    float dt;
+    Camera3D camera;
+    Vector3 cubePosition;
+    std::vector<SceneDrawItem> drawItems;
+    std::vector<LuaDrawCommand> luaCommands;
+    std::vector<ParticleDrawBatch> particles;
+    SceneStats sceneStats;
+    double simulationTime;
+} FramePacket;
+
+// -----------------------------------------------------------------------------
+// Simulacion en un hilo propio con dos paquetes: mientras el hilo principal
+// dibuja el paquete N, la simulacion escribe el N+1 en el otro
+// -----------------------------------------------------------------------------
+class FramePipeline {
+public:
+    typedef std::function<void(const SimulationInput&, FramePacket&)> SimulateFn;
+
+    ~FramePipeline() { Stop(); }
+
+    void Start(SimulateFn simulateFn);
+    void Stop();
+
+    void Submit(const SimulationInput& input);     // Lanza la simulacion del siguiente frame
+    FramePacket* Wait();                            // Espera a que termine y devuelve su paquete
+
+private:
+    void ThreadLoop();
+
+    FramePacket packets[2];
+    int writeIndex = 0;
+    SimulationInput pending;
+    SimulateFn simulate;
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable workReady;
+    std::condition_variable workDone;
+    bool hasWork = false;
+    bool busy = false;
+    bool stopping = false;
+};
+
+#endif
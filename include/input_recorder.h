@@ -0,0 +1,80 @@
+#ifndef INPUT_RECORDER_H
+#define INPUT_RECORDER_H
+
+#include "raylib.h"
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+// Teclas y botones que lee el juego; cada uno es un bit de
+// InputFrame::keysDown/keysPressed. Los botones del raton van detras de las
+// teclas para que las grabaciones anteriores sigan valiendo
+typedef enum {
+    INPUT_KEY_W,
+    INPUT_KEY_S,
+    INPUT_KEY_A,
+    INPUT_KEY_D,
+    INPUT_KEY_SPACE,
+    INPUT_KEY_Q,
+    INPUT_KEY_E,
+    INPUT_KEY_LEFT_CONTROL,
+    INPUT_KEY_UP,
+    INPUT_KEY_DOWN,
+    INPUT_KEY_LEFT,
+    INPUT_KEY_RIGHT,
+    INPUT_MOUSE_MIDDLE,             // Paneo de la camara libre
+    INPUT_KEY_COUNT
+} InputKey;
+
+// Snapshot de la entrada de un frame. Todo el juego lee de aqui en vez de
+// llamar a IsKeyDown/GetMouseDelta, para que la repeticion sea exacta
+typedef struct {
+    float dt;
+    unsigned short keysDown;
+    unsigned short keysPressed;
+    Vector2 mouseDelta;
+    float mouseWheel;
+    std::vector<std::string> droppedFiles;
+} InputFrame;
+
+inline bool IsInputDown(const InputFrame* frame, InputKey key) { return (frame->keysDown >> key) & 1; }
+inline bool IsInputPressed(const InputFrame* frame, InputKey key) { return (frame->keysPressed >> key) & 1; }
+
+// Equivalente a UpdateCamera(CAMERA_FREE) pero alimentado por el snapshot
+void UpdateCameraFromInput(Camera3D* camera, const InputFrame* frame);
+
+// -----------------------------------------------------------------------------
+// Grabacion y repeticion de la entrada en un flujo binario compacto:
+// cabecera "GEIN" + version, y por frame dt, mascaras de teclas, un byte de
+// flags y solo los campos que no son cero (raton, rueda, archivos soltados)
+// -----------------------------------------------------------------------------
+class InputRecorder {
+public:
+    ~InputRecorder() { Stop(); }
+
+    bool StartRecording(const char* fileName);
+    bool StartReplay(const char* fileName);
+    void Stop();
+
+    // Rellena frame con la entrada en vivo (grabandola si toca) o con el
+    // siguiente frame de la repeticion
+    void Poll(InputFrame* frame);
+
+    bool IsRecording() const { return recording; }
+    bool IsReplaying() const { return replaying; }
+    bool IsFinished() const { return finished; }    // La repeticion llego al final
+    int GetFrameCount() const { return frameCount; }
+
+private:
+    void PollLive(InputFrame* frame);
+    void WriteFrame(const InputFrame* frame);
+    bool ReadFrame(InputFrame* frame);
+
+    FILE* file = NULL;
+    bool recording = false;
+    bool replaying = false;
+    bool finished = false;
+    int frameCount = 0;
+};
+
+#endif
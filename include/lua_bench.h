@@ -0,0 +1,9 @@
+#ifndef LUA_BENCH_H
+#define LUA_BENCH_H
+
+// Compara el coste por llamada de un binding escrito a mano (lua_tonumber +
+// casts, como los antiguos de SimpleDraw) con el generado por LuaBind<>, sin
+// ventana y con destinos que no dibujan. Se lanza con --luabench
+int RunLuaBindingBenchmark(void);
+
+#endif
@@ -0,0 +1,378 @@
+#ifndef LUA_BIND_H
+#define LUA_BIND_H
+
+#include "raylib.h"
+#include "lua.hpp"
+#include <stddef.h>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+
+// -----------------------------------------------------------------------------
+// Generador de bindings para Lua en tiempo de compilacion.
+//
+//   { "DrawCircle", LuaBind<DrawCircle> }
+//
+// LuaBind<F> lee los argumentos de la pila directamente a la firma de F, con
+// comprobacion de tipos (luaL_check*: un argumento incorrecto es un error de
+// Lua, no un 0 silencioso). Vector2/Vector3/Color/Camera3D viajan como
+// userdata sin cajas intermedias, o como numeros sueltos por compatibilidad
+// con los scripts existentes. Las clases del motor se exponen con LuaClass<T>:
+// el objeto se empaqueta una vez al pasarlo a Lua y las llamadas a metodos no
+// reservan memoria.
+//
+// Nota: luaL_error hace longjmp, asi que los argumentos std::string pueden
+// perder memoria si otro argumento falla; en los bindings calientes usar
+// const char*.
+// -----------------------------------------------------------------------------
+
+template <typename T, typename Enable = void>
+struct LuaValue;
+
+// Nombre de la metatabla de cada tipo por valor
+template <typename T> struct LuaUserType;
+template <> struct LuaUserType<Vector2> { static constexpr const char* name = "Vector2"; };
+template <> struct LuaUserType<Vector3> { static constexpr const char* name = "Vector3"; };
+template <> struct LuaUserType<Color> { static constexpr const char* name = "Color"; };
+template <> struct LuaUserType<Camera3D> { static constexpr const char* name = "Camera3D"; };
+
+// Lectura de numeros con una sola llamada a la API en el caso normal, como los
+// bindings a mano; si el argumento no vale, luaL_check* da el error de siempre
+inline lua_Number LuaCheckNumber(lua_State* L, int idx)
+{
+    int isnum;
+    lua_Number value = lua_tonumberx(L, idx, &isnum);
+    return isnum ? value : luaL_checknumber(L, idx);
+}
+
+inline lua_Integer LuaCheckInteger(lua_State* L, int idx)
+{
+    int isnum;
+    lua_Integer value = lua_tointegerx(L, idx, &isnum);
+    return isnum ? value : luaL_checkinteger(L, idx);
+}
+
+// Numeros. Los enteros se truncan igual que hacian los bindings a mano
+template <typename T>
+struct LuaValue<T, typename std::enable_if<std::is_arithmetic<T>::value && !std::is_same<T, bool>::value>::type> {
+    static T Get(lua_State* L, int& idx) { return (T)LuaCheckNumber(L, idx++); }
+    static void Push(lua_State* L, T value) { lua_pushnumber(L, (lua_Number)value); }
+};
+
+template <>
+struct LuaValue<bool> {
+    static bool Get(lua_State* L, int& idx) { return lua_toboolean(L, idx++) != 0; }
+    static void Push(lua_State* L, bool value) { lua_pushboolean(L, value); }
+};
+
+template <>
+struct LuaValue<const char*> {
+    static const char* Get(lua_State* L, int& idx) { return luaL_checkstring(L, idx++); }
+    static void Push(lua_State* L, const char* value) { lua_pushstring(L, value); }
+};
+
+template <>
+struct LuaValue<std::string> {
+    static std::string Get(lua_State* L, int& idx) { return luaL_checkstring(L, idx++); }
+    static void Push(lua_State* L, const std::string& value) { lua_pushstring(L, value.c_str()); }
+};
+
+// Tipos por valor: userdata con el struct dentro, tal cual. Get prueba antes
+// los numeros sueltos, que es lo que pasan casi todos los scripts, y solo si
+// el primero no es un numero mira si es el userdata
+template <typename T>
+struct LuaUserValue {
+    // Las cajas llevan &LuaUserType<T>::name en su valor de usuario: mirarlo
+    // cuesta menos llamadas a la API que comparar la metatabla por nombre
+    // (luaL_testudata). lua_getiuservalue solo admite userdata completos
+    static T* Test(lua_State* L, int idx)
+    {
+        if (lua_type(L, idx) != LUA_TUSERDATA) return NULL;
+        void* tag = (lua_getiuservalue(L, idx, 1) == LUA_TLIGHTUSERDATA) ? lua_touserdata(L, -1) : NULL;
+        lua_pop(L, 1);
+        return tag == (void*)&LuaUserType<T>::name ? (T*)lua_touserdata(L, idx) : NULL;
+    }
+
+    static void Push(lua_State* L, const T& value)
+    {
+        T* data = (T*)lua_newuserdata(L, sizeof(T));
+        *data = value;
+        lua_pushlightuserdata(L, (void*)&LuaUserType<T>::name);
+        lua_setiuservalue(L, -2, 1);
+        luaL_setmetatable(L, LuaUserType<T>::name);
+    }
+};
+
+template <>
+struct LuaValue<Vector2> : LuaUserValue<Vector2> {
+    static Vector2 Get(lua_State* L, int& idx)
+    {
+        int isnum;
+        Vector2 v;
+        v.x = (float)lua_tonumberx(L, idx, &isnum);
+        if (!isnum)
+        {
+            if (Vector2* data = Test(L, idx)) { idx++; return *data; }
+            v.x = (float)luaL_checknumber(L, idx);
+        }
+        idx++;
+        v.y = (float)LuaCheckNumber(L, idx++);
+        return v;
+    }
+};
+
+template <>
+struct LuaValue<Vector3> : LuaUserValue<Vector3> {
+    static Vector3 Get(lua_State* L, int& idx)
+    {
+        int isnum;
+        Vector3 v;
+        v.x = (float)lua_tonumberx(L, idx, &isnum);
+        if (!isnum)
+        {
+            if (Vector3* data = Test(L, idx)) { idx++; return *data; }
+            v.x = (float)luaL_checknumber(L, idx);
+        }
+        idx++;
+        v.y = (float)LuaCheckNumber(L, idx++);
+        v.z = (float)LuaCheckNumber(L, idx++);
+        return v;
+    }
+};
+
+// Color: userdata o r, g, b y alfa (255 si no se pasa; solo puede omitirse
+// cuando el Color es el ultimo argumento). Cada componente debe ser un entero
+// en 0..255: convertir un double fuera de rango a unsigned char es UB
+template <>
+struct LuaValue<Color> : LuaUserValue<Color> {
+    static unsigned char Channel(lua_State* L, int idx, lua_Integer value)
+    {
+        luaL_argcheck(L, value >= 0 && value <= 255, idx, "componente de color fuera de 0..255");
+        return (unsigned char)value;
+    }
+
+    static Color Get(lua_State* L, int& idx)
+    {
+        int isnum;
+        lua_Integer r = lua_tointegerx(L, idx, &isnum);
+        if (!isnum)
+        {
+            if (Color* data = Test(L, idx)) { idx++; return *data; }
+            r = luaL_checkinteger(L, idx);
+        }
+        Color c;
+        c.r = Channel(L, idx, r); idx++;
+        c.g = Channel(L, idx, LuaCheckInteger(L, idx)); idx++;
+        c.b = Channel(L, idx, LuaCheckInteger(L, idx)); idx++;
+        lua_Integer a = lua_tointegerx(L, idx, &isnum);
+        if (!isnum) a = luaL_optinteger(L, idx, 255);
+        c.a = Channel(L, idx, a); idx++;
+        return c;
+    }
+};
+
+template <>
+struct LuaValue<Camera3D> : LuaUserValue<Camera3D> {
+    static Camera3D Get(lua_State* L, int& idx)
+    {
+        if (Camera3D* c = Test(L, idx)) { idx++; return *c; }
+        Camera3D c;
+        c.position = LuaValue<Vector3>::Get(L, idx);
+        c.target = LuaValue<Vector3>::Get(L, idx);
+        c.up = LuaValue<Vector3>::Get(L, idx);
+        c.fovy = (float)luaL_checknumber(L, idx++);
+        c.projection = (int)luaL_optinteger(L, idx++, CAMERA_PERSPECTIVE);
+        return c;
+    }
+};
+
+// -----------------------------------------------------------------------------
+// Clases del motor. Lua guarda un puntero en un userdata de tamano fijo; el
+// objeto sigue perteneciendo a C++. Hay una sola caja por objeto, guardada en
+// una tabla de valores debiles: volver a pasar el mismo objeto no reserva
+// memoria y == compara identidad
+// -----------------------------------------------------------------------------
+template <typename T>
+struct LuaClass {
+    static const char* name;
+
+    // Crea la metatabla de las instancias (metodos en __index) y una tabla
+    // global con las funciones estaticas
+    static void Register(lua_State* L, const char* className, const luaL_Reg* methods, const luaL_Reg* statics = NULL)
+    {
+        name = className;
+        luaL_newmetatable(L, className);
+        lua_newtable(L);
+        luaL_setfuncs(L, methods, 0);
+        lua_setfield(L, -2, "__index");
+        lua_pop(L, 1);
+
+        lua_newtable(L);
+        if (statics != NULL) luaL_setfuncs(L, statics, 0);
+        lua_setglobal(L, className);
+    }
+
+    static T* Check(lua_State* L, int idx)
+    {
+        RequireRegistered(L);
+        return *(T**)luaL_checkudata(L, idx, name);
+    }
+
+    static void Push(lua_State* L, T* object)
+    {
+        if (object == NULL) { lua_pushnil(L); return; }
+        RequireRegistered(L);
+
+        PushCache(L);
+        if (lua_rawgetp(L, -1, object) == LUA_TUSERDATA)
+        {
+            lua_remove(L, -2);
+            return;
+        }
+        lua_pop(L, 1);
+
+        T** box = (T**)lua_newuserdata(L, sizeof(T*));
+        *box = object;
+        luaL_setmetatable(L, name);
+        lua_pushvalue(L, -1);
+        lua_rawsetp(L, -3, object);
+        lua_remove(L, -2);
+    }
+
+private:
+    // Sin Register() el nombre de la metatabla es NULL y luaL_checkudata o
+    // luaL_setmetatable fallarian sin decir por que
+    static void RequireRegistered(lua_State* L)
+    {
+        if (name == NULL) luaL_error(L, "clase de C++ sin registrar en Lua: %s", typeid(T).name());
+    }
+
+    // Tabla puntero -> caja de esta clase en el registro (clave: &name, una
+    // direccion distinta por T)
+    static void PushCache(lua_State* L)
+    {
+        if (lua_rawgetp(L, LUA_REGISTRYINDEX, &name) == LUA_TTABLE) return;
+        lua_pop(L, 1);
+
+        lua_newtable(L);
+        lua_newtable(L);
+        lua_pushstring(L, "v");
+        lua_setfield(L, -2, "__mode");
+        lua_setmetatable(L, -2);
+        lua_pushvalue(L, -1);
+        lua_rawsetp(L, LUA_REGISTRYINDEX, &name);
+    }
+};
+
+template <typename T>
+const char* LuaClass<T>::name = NULL;
+
+template <typename T>
+struct LuaValue<T*, typename std::enable_if<std::is_class<T>::value>::type> {
+    static T* Get(lua_State* L, int& idx) { return LuaClass<T>::Check(L, idx++); }
+    static void Push(lua_State* L, T* object) { LuaClass<T>::Push(L, object); }
+};
+
+// -----------------------------------------------------------------------------
+// Invocacion. Los argumentos se leen dentro de una lista entre llaves, que
+// garantiza el orden de izquierda a derecha (necesario porque un Color o un
+// Vector3 sueltos consumen varias posiciones de la pila)
+// -----------------------------------------------------------------------------
+template <typename T>
+using LuaArg = typename std::remove_cv<typename std::remove_reference<T>::type>::type;
+
+template <typename R>
+struct LuaReturn {
+    template <typename F, typename Tuple>
+    static int Call(lua_State* L, F&& f, Tuple& args)
+    {
+        LuaValue<LuaArg<R>>::Push(L, std::apply(f, args));
+        return 1;
+    }
+};
+
+template <>
+struct LuaReturn<void> {
+    template <typename F, typename Tuple>
+    static int Call(lua_State*, F&& f, Tuple& args)
+    {
+        std::apply(f, args);
+        return 0;
+    }
+};
+
+template <typename F>
+struct LuaInvoker;
+
+template <typename R, typename... Args>
+struct LuaInvoker<R(*)(Args...)> {
+    template <R(*Func)(Args...)>
+    static int Call(lua_State* L)
+    {
+        [[maybe_unused]] int idx = 1;       // Sin uso si Func no tiene argumentos
+        std::tuple<LuaArg<Args>...> args{ LuaValue<LuaArg<Args>>::Get(L, idx)... };
+        return LuaReturn<R>::Call(L, Func, args);
+    }
+};
+
+template <typename T, typename R, typename... Args>
+struct LuaInvoker<R(T::*)(Args...)> {
+    template <R(T::*Method)(Args...)>
+    static int Call(lua_State* L)
+    {
+        int idx = 1;
+        T* self = LuaClass<T>::Check(L, idx++);
+        std::tuple<LuaArg<Args>...> args{ LuaValue<LuaArg<Args>>::Get(L, idx)... };
+        return LuaReturn<R>::Call(L, [self](LuaArg<Args>... a) -> R { return (self->*Method)(a...); }, args);
+    }
+};
+
+template <typename T, typename R, typename... Args>
+struct LuaInvoker<R(T::*)(Args...) const> {
+    template <R(T::*Method)(Args...) const>
+    static int Call(lua_State* L)
+    {
+        int idx = 1;
+        const T* self = LuaClass<T>::Check(L, idx++);
+        std::tuple<LuaArg<Args>...> args{ LuaValue<LuaArg<Args>>::Get(L, idx)... };
+        return LuaReturn<R>::Call(L, [self](LuaArg<Args>... a) -> R { return (self->*Method)(a...); }, args);
+    }
+};
+
+// Funciones libres, estaticas y metodos
+template <auto Func>
+int LuaBind(lua_State* L)
+{
+    return LuaInvoker<decltype(Func)>::template Call<Func>(L);
+}
+
+// Campos de una clase expuestos como getter/setter
+template <typename T, typename V, V T::*Field>
+int LuaGetField(lua_State* L)
+{
+    LuaValue<V>::Push(L, LuaClass<T>::Check(L, 1)->*Field);
+    return 1;
+}
+
+template <typename T, typename V, V T::*Field>
+int LuaSetField(lua_State* L)
+{
+    int idx = 2;
+    LuaClass<T>::Check(L, 1)->*Field = LuaValue<V>::Get(L, idx);
+    return 0;
+}
+
+// Constructor de un tipo por valor: SimpleDraw.Color(255, 0, 0)
+template <typename T>
+int LuaConstruct(lua_State* L)
+{
+    int idx = 1;
+    LuaValue<T>::Push(L, LuaValue<T>::Get(L, idx));
+    return 1;
+}
+
+// Registra las metatablas de Vector2/Vector3/Color/Camera3D (acceso a campos)
+void LuaRegisterValueTypes(lua_State* L);
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef MESH_LOD_H
+#define MESH_LOD_H
+
+#include "raylib.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#define MAX_LOD_LEVELS 4
+
+// Cadena de LODs de un mesh. levels[0] es una copia superficial del mesh
+// original (no se libera aqui); el resto los genera el LodBuilder
+typedef struct {
+    Mesh levels[MAX_LOD_LEVELS];
+    int levelCount;
+} MeshLods;
+
+// Simplificacion por colapso de aristas con cuadricas de error (solo CPU, no
+// sube nada a la GPU). Devuelve false si el mesh no se puede simplificar
+bool SimplifyMesh(const Mesh& source, int targetTriangles, Mesh* result);
+void FreeMeshData(Mesh* mesh);
+
+// Elige el nivel a partir del tamano proyectado (radio / semialtura de la
+// vista), con histeresis para que no parpadee en los umbrales
+int SelectLodLevel(float screenSize, int currentLevel, int levelCount);
+
+// -----------------------------------------------------------------------------
+// Genera los LODs en hilos de trabajo. Update() se llama desde el hilo
+// principal (el del contexto OpenGL) y sube los meshes terminados
+// -----------------------------------------------------------------------------
+class LodBuilder {
+public:
+    static LodBuilder* getInstance();
+
+    void Request(const void* owner, MeshLods* target);
+    void Cancel(const void* owner);             // Bloquea hasta que los hilos sueltan a owner
+    void Update(int maxUploads = 2);
+    void Shutdown();
+
+private:
+    typedef struct {
+        const void* owner;
+        MeshLods* target;
+        Mesh source;
+        Mesh results[MAX_LOD_LEVELS - 1];
+        int resultCount;
+    } LodJob;
+
+    LodBuilder() {}
+    void Start();
+    void WorkerLoop();
+
+    std::vector<std::thread> workers;
+    std::deque<LodJob*> pending;
+    std::vector<LodJob*> running;
+    std::deque<LodJob*> done;
+    std::mutex mutex;
+    std::condition_variable jobReady;
+    std::condition_variable jobFinished;
+    bool stopping = false;
+};
+
+#endif
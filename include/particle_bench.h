@@ -0,0 +1,9 @@
+#ifndef PARTICLE_BENCH_H
+#define PARTICLE_BENCH_H
+
+// Mide sin ventana el coste de actualizar 1M de particulas por frame con el
+// kernel escalar y con el SIMD, y el frame completo del ParticleSystem
+// (emision, actualizacion y copia para el render). Se lanza con --particlebench
+int RunParticleBenchmark(void);
+
+#endif
@@ -0,0 +1,100 @@
+#ifndef PARTICLE_SYSTEM_H
+#define PARTICLE_SYSTEM_H
+
+#include "raylib.h"
+#include "quad_buffer.h"
+#include <stdint.h>
+#include <vector>
+
+// Configuracion de un emisor 2D (coordenadas de pantalla)
+typedef struct {
+    Vector2 position;
+    Vector2 velocity;       // Velocidad inicial media
+    Vector2 spread;         // Variacion aleatoria +-spread sobre velocity
+    Vector2 gravity;
+    float drag;             // Fraccion de velocidad perdida por segundo
+    float lifetime;         // Segundos
+    float size;             // Lado del quad en pixeles
+    Color startColor;
+    Color endColor;         // Se interpola con la edad
+    int capacity;
+} EmitterConfig;
+
+EmitterConfig DefaultEmitterConfig(void);
+
+// Estado de las particulas en SoA: un array por componente, alineados a 32
+// bytes y con la capacidad redondeada a 8 para que los kernels SIMD no
+// necesiten cola escalar
+typedef struct {
+    float* px;
+    float* py;
+    float* vx;
+    float* vy;
+    float* life;            // Tiempo restante; <= 0 muere
+    int count;
+    int capacity;
+} ParticleBuffers;
+
+bool AllocParticleBuffers(ParticleBuffers* buffers, int capacity);
+void FreeParticleBuffers(ParticleBuffers* buffers);
+
+// Kernels de actualizacion: integracion (gravedad, arrastre, posicion) y
+// descarte de las muertas. Devuelve cuantas quedan vivas
+int UpdateParticlesScalar(ParticleBuffers* buffers, float dt, Vector2 gravity, float drag);
+int UpdateParticlesSimd(ParticleBuffers* buffers, float dt, Vector2 gravity, float drag);
+const char* GetParticleKernelName(void);
+
+// Copia inmutable de un emisor para el hilo de render
+typedef struct {
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> life;
+    float size;
+    float lifetime;
+    Color startColor;
+    Color endColor;
+} ParticleDrawBatch;
+
+// Un QuadBuffer por emisor con la textura blanca por defecto: una subida y
+// un draw por emisor y frame. Hilo principal
+class ParticleRenderer {
+public:
+    void Draw(const std::vector<ParticleDrawBatch>& batches);
+    void Unload();
+
+private:
+    std::vector<QuadBuffer> buffers;            // Se reutilizan entre frames
+};
+
+// -----------------------------------------------------------------------------
+// Sistema de particulas nativo. Los emisores se crean y disparan desde Lua
+// (ParticleSystem.getInstance():Emit(id, n)); Update() y Snapshot() corren en
+// el hilo de simulacion
+// -----------------------------------------------------------------------------
+class ParticleSystem {
+public:
+    static ParticleSystem* getInstance();
+    ~ParticleSystem() { Clear(); }
+
+    int CreateEmitter(EmitterConfig config);
+    void Emit(int emitter, int count);
+    void SetEmitterPosition(int emitter, Vector2 position);
+    int GetParticleCount() const;
+
+    void Update(float dt);
+    void Snapshot(std::vector<ParticleDrawBatch>& out) const;
+    void Clear();
+
+private:
+    typedef struct {
+        EmitterConfig config;
+        ParticleBuffers buffers;
+    } Emitter;
+
+    float RandomRange(float spread);
+
+    std::vector<Emitter> emitters;
+    uint32_t randomState = 0x9E3779B9u;
+};
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef QUAD_BUFFER_H
+#define QUAD_BUFFER_H
+
+#include "raylib.h"
+#include <stddef.h>
+#include <utility>
+#include <vector>
+
+// Vertice 2D con coordenadas de textura y color (atributos del shader por
+// defecto de raylib)
+typedef struct {
+    float x, y;
+    float u, v;
+    Color color;
+} QuadVertex;
+
+// Dos triangulos con el mismo orden de vertices que DrawTexturePro
+static inline void WriteQuad(QuadVertex* v, float x0, float y0, float x1, float y1,
+    float u0, float v0, float u1, float v1, Color color)
+{
+    v[0] = QuadVertex{ x0, y0, u0, v0, color };
+    v[1] = QuadVertex{ x0, y1, u0, v1, color };
+    v[2] = QuadVertex{ x1, y1, u1, v1, color };
+    v[3] = v[0];
+    v[4] = v[2];
+    v[5] = QuadVertex{ x1, y0, u1, v0, color };
+}
+
+// -----------------------------------------------------------------------------
+// Quads 2D en un buffer de vertices propio en la GPU. Se rellenan en CPU y
+// Draw() los sube con rlUpdateVertexBuffer y los dibuja con una sola llamada,
+// sin pasar por el batch inmediato de rlgl (que se vacia cada 8192 quads).
+// Son triangulos sueltos, 6 vertices por quad: rlDrawVertexArrayElements solo
+// admite indices de 16 bits y limitaria cada llamada a 16384 quads.
+//
+// Sin VAOs (OpenGL 2.1, ES2 sin la extension) el buffer y los atributos se
+// enlazan en cada Draw(), como hace DrawMesh; sin VBOs (OpenGL 1.1) los quads
+// van por el batch inmediato de rlgl.
+//
+// Guarda handles de OpenGL sin destructor (se liberan con Unload(), con el
+// contexto vivo), asi que no se puede copiar; moverlo deja el origen vacio
+// -----------------------------------------------------------------------------
+class QuadBuffer {
+public:
+    QuadBuffer() = default;
+    QuadBuffer(const QuadBuffer&) = delete;
+    QuadBuffer& operator=(const QuadBuffer&) = delete;
+    QuadBuffer(QuadBuffer&& other) noexcept
+        : vertices(std::move(other.vertices)), vao(other.vao), vbo(other.vbo), capacity(other.capacity)
+    {
+        other.vao = 0;
+        other.vbo = 0;
+        other.capacity = 0;
+    }
+
+    void Clear() { vertices.clear(); }
+
+    // Reserva count quads al final y devuelve sus 6 * count vertices
+    QuadVertex* AddQuads(int count)
+    {
+        size_t first = vertices.size();
+        vertices.resize(first + (size_t)count * 6);
+        return vertices.data() + first;
+    }
+
+    int GetQuadCount() const { return (int)vertices.size() / 6; }
+
+    void Draw(unsigned int textureId);          // Hilo principal (contexto OpenGL)
+    void Unload();
+
+private:
+    void Allocate(int vertexCount);
+    void SetAttributes();
+    void DrawImmediate(unsigned int textureId);
+
+    std::vector<QuadVertex> vertices;
+    unsigned int vao = 0;
+    unsigned int vbo = 0;
+    int capacity = 0;                           // Vertices que caben en vbo
+};
+
+#endif
@@ -0,0 +1,97 @@
+#ifndef SCENE_INDEX_H
+#define SCENE_INDEX_H
+
+#include "raylib.h"
+#include "mesh_lod.h"
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Modelo de escena: el Model de raylib mas los bounds de cada mesh, calculados
+// una sola vez al cargar (espacio del modelo, con model.transform aplicada), y
+// sus LODs, que se generan en segundo plano y van apareciendo a medida que
+// terminan
+// -----------------------------------------------------------------------------
+typedef struct {
+    Model model;
+    std::vector<BoundingBox> meshBounds;
+    BoundingBox bounds;                     // Union de todos los meshBounds
+    std::vector<MeshLods> lods;             // Paralelo a model.meshes
+} SceneModel;
+
+bool LoadSceneModel(SceneModel* sceneModel, const char* fileName);
+bool InitSceneModel(SceneModel* sceneModel, Model model);     // Adopta un Model ya subido a la GPU
+void RefreshSceneModelBounds(SceneModel* sceneModel);
+void UnloadSceneModel(SceneModel* sceneModel);
+
+// Instancia colocada en el mundo. Sin rotacion: solo posicion y escala uniforme
+typedef struct {
+    SceneModel* source;
+    Vector3 position;
+    float scale;
+    bool enabled;
+    int lodLevel;                           // Nivel actual, para la histeresis
+} SceneInstance;
+
+// Un mesh que sobrevivio al culling, listo para DrawMesh
+typedef struct {
+    const Mesh* mesh;
+    const Material* material;
+    Matrix transform;
+} SceneDrawItem;
+
+// Contadores del ultimo Cull(), para verificar el ahorro
+typedef struct {
+    int instances;
+    int visibleInstances;
+    int visibleMeshes;
+    int culledMeshes;
+    int nodesVisited;
+    int triangles;                          // Triangulos enviados tras elegir LOD
+    int lodMeshes[MAX_LOD_LEVELS];
+} SceneStats;
+
+// -----------------------------------------------------------------------------
+// Indice espacial de la escena: BVH sobre las instancias colocadas, con
+// frustum culling y culling por distancia opcional contra una Camera3D
+// -----------------------------------------------------------------------------
+class SceneIndex {
+public:
+    int AddInstance(SceneModel* source, Vector3 position, float scale);
+    void RemoveInstance(int id);
+    void SetInstancePosition(int id, Vector3 position);
+    void MarkDirty() { dirty = true; }          // Llamar si cambian los bounds de un SceneModel
+
+    // maxDistance <= 0 desactiva el culling por distancia
+    void SetMaxDrawDistance(float distance) { maxDrawDistance = distance; }
+
+    void Cull(const Camera3D& camera, float aspect, std::vector<SceneDrawItem>& out);
+    void Draw(const Camera3D& camera, float aspect);
+
+    const SceneStats& GetStats() const { return stats; }
+
+private:
+    typedef struct {
+        BoundingBox box;
+        int left;           // -1 en las hojas
+        int right;
+        int first;          // Rango dentro de order (solo hojas)
+        int count;
+    } BvhNode;
+
+    void Rebuild();
+    int BuildNode(int first, int count);
+
+    std::vector<SceneInstance> instances;
+    std::vector<BoundingBox> worldBounds;   // Paralelo a instances
+    std::vector<int> order;                 // Instancias activas, agrupadas por hoja
+    std::vector<BvhNode> nodes;
+    std::vector<int> freeIds;
+    std::vector<SceneDrawItem> drawItems;   // Reutilizado por Draw() para no reservar cada frame
+    float maxDrawDistance = 0.0f;
+    bool dirty = true;
+    SceneStats stats = { 0 };
+};
+
+void DrawSceneItems(const std::vector<SceneDrawItem>& items);
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef SPRITE_BATCH_H
+#define SPRITE_BATCH_H
+
+#include "raylib.h"
+#include "quad_buffer.h"
+#include <stddef.h>
+#include <vector>
+
+#define ATLAS_PAGE_SIZE 2048
+#define ATLAS_PADDING 2
+
+// Un sprite dentro del atlas: pagina y rectangulo en pixeles
+typedef struct {
+    int page;
+    Rectangle source;
+} Sprite;
+
+// -----------------------------------------------------------------------------
+// Atlas de texturas: las imagenes se anaden en CPU y Build() las empaqueta
+// (skyline bottom-left, de mayor a menor altura) en paginas que se suben a la
+// GPU una sola vez
+// -----------------------------------------------------------------------------
+class SpriteAtlas {
+public:
+    int AddImage(const char* fileName);         // Devuelve el id del sprite, -1 si falla
+    int AddImage(Image image);                  // El atlas se queda con la imagen
+    bool Build();
+    void Unload();
+
+    const Sprite& GetSprite(int id) const { return sprites[id]; }
+    Texture2D GetPage(int page) const { return pages[page]; }
+    int GetPageCount() const { return (int)pages.size(); }
+
+private:
+    typedef struct {
+        int x;
+        int y;
+        int width;
+    } SkylineNode;
+
+    typedef struct {
+        int size;
+        std::vector<SkylineNode> skyline;
+        Image image;
+    } PackPage;
+
+    static bool SkylineFit(const PackPage& page, int index, int width, int height, int* y);
+    static bool SkylineInsert(PackPage& page, int width, int height, int* x, int* y);
+
+    std::vector<Image> images;                  // Pendientes de Build(), paralelo a sprites
+    std::vector<Sprite> sprites;
+    std::vector<Texture2D> pages;
+};
+
+// -----------------------------------------------------------------------------
+// Lote de sprites: Draw() solo acumula vertices en el QuadBuffer de la pagina
+// correspondiente; End() los sube y dibuja cada pagina con una sola llamada
+// -----------------------------------------------------------------------------
+class SpriteBatch {
+public:
+    void Begin(const SpriteAtlas* atlas);
+    void Draw(int sprite, Vector2 position, float scale, Color tint);
+    void End();
+    void Unload();                              // Libera los buffers de GPU
+
+    int GetSpriteCount() const { return spriteCount; }
+    int GetPageSubmits() const { return pageSubmits; }
+
+private:
+    const SpriteAtlas* atlas = NULL;
+    std::vector<QuadBuffer> pageBuffers;        // Se reutilizan entre frames
+    int spriteCount = 0;
+    int pageSubmits = 0;
+};
+
+#endif
@@ -0,0 +1,183 @@
+#ifndef WORLD_STREAMING_H
+#define WORLD_STREAMING_H
+
+#include "raylib.h"
+#include "scene_index.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class GameObject;
+
+// Parametros del streaming (config.ini: chunksize, streamradius, streammb)
+typedef struct {
+    float chunkSize;            // Lado de un chunk en unidades del mundo (plano XZ)
+    int loadRadius;             // Chunks alrededor de la camara; se descargan a loadRadius + 1
+    float prefetchSeconds;      // Cuanto se adelanta la prediccion segun la velocidad
+    int memoryBudgetMB;         // Tope de memoria residente de los assets (GPU)
+    float uploadBudgetMs;       // Tiempo maximo por frame para crear recursos en GPU
+} WorldStreamConfig;
+
+// -----------------------------------------------------------------------------
+// Contenido de un chunk: <directorio>/chunk_<x>_<z>.txt, una entrada por linea
+// y en coordenadas del mundo:
+//
+//   # comentario
+//   model <archivo.obj> <textura.png|-> <x> <y> <z> <escala>
+//   object <nombre> <x> <y> <ancho> <alto>
+// -----------------------------------------------------------------------------
+typedef struct {
+    std::string model;
+    std::string texture;
+    Vector3 position;
+    float scale;
+} ChunkModelEntry;
+
+typedef struct {
+    std::string name;
+    Vector2 position;
+    Vector2 size;
+} ChunkObjectEntry;
+
+bool ParseChunkFile(const char* fileName, std::vector<ChunkModelEntry>* models, std::vector<ChunkObjectEntry>* objects);
+
+// OBJ a un mesh sin indices listo para UploadMesh (solo memoria de CPU, se
+// puede llamar desde cualquier hilo). Los .mtl se ignoran: la textura la da
+// el chunk
+bool ParseObjMesh(const char* fileName, Mesh* mesh);
+
+typedef struct {
+    int residentChunks;
+    int loadingChunks;
+    int assets;
+    int instances;
+    int objects;
+    size_t residentBytes;
+    size_t budgetBytes;
+    int evictions;              // Chunks descargados por el tope de memoria
+    float updateMs;             // Coste del ultimo Update() en el hilo principal
+} WorldStreamStats;
+
+// -----------------------------------------------------------------------------
+// Particion del mundo en chunks que se cargan y descargan alrededor de la
+// camara. Un hilo lee los archivos de chunk, parsea los OBJ y decodifica las
+// imagenes; el hilo principal solo sube meshes y texturas a la GPU, con un
+// presupuesto de tiempo por frame, y da de alta las instancias en la
+// SceneIndex.
+//
+// Update() toca la SceneIndex, asi que se llama con la simulacion parada
+// (entre FramePipeline::Wait y Submit). Los assets que dejan de usarse no se
+// liberan hasta ReleaseRetired(), despues de dibujar el paquete actual, que
+// todavia puede apuntar a sus meshes
+// -----------------------------------------------------------------------------
+class WorldStreamer {
+public:
+    ~WorldStreamer() { Shutdown(); }
+
+    void Init(const char* directory, const WorldStreamConfig& config, SceneIndex* scene);
+    void Shutdown();
+
+    void Update(Vector3 cameraPosition, float dt);
+    void ReleaseRetired();
+
+    const WorldStreamStats& GetStats() const { return stats; }
+
+private:
+    typedef enum {
+        CHUNK_QUEUED,           // En manos del hilo de carga
+        CHUNK_LOADING,          // Parseado; creando recursos en el hilo principal
+        CHUNK_RESIDENT
+    } ChunkState;
+
+    typedef enum {
+        ASSET_QUEUED,           // En manos del hilo de carga
+        ASSET_PARSED,           // Mesh e imagen en CPU, esperando a subirse
+        ASSET_READY,
+        ASSET_FAILED            // Se queda en la cache para no reintentarlo
+    } AssetState;
+
+    // Modelo + textura compartidos entre chunks con cuenta de referencias
+    typedef struct {
+        std::string key;
+        std::string modelFile;
+        std::string textureFile;
+        AssetState state;
+        bool cancelled;         // Sin referencias mientras lo parseaba el hilo
+        Mesh mesh;              // Datos de CPU hasta la subida
+        Image image;
+        SceneModel model;
+        Texture2D texture;
+        size_t bytes;
+        int refCount;
+    } StreamAsset;
+
+    typedef struct {
+        int x;
+        int z;
+        ChunkState state;
+        bool cancelled;                         // Descartado mientras lo parseaba el hilo
+        std::vector<ChunkModelEntry> models;
+        std::vector<ChunkObjectEntry> objects;
+        size_t nextModel;                       // Progreso del alta en la escena
+        size_t nextObject;
+        std::vector<StreamAsset*> assets;       // Paralelo a models
+        std::vector<int> instances;
+        std::vector<GameObject*> spawned;       // Los nextObject primeros de objects; son del chunk
+    } StreamChunk;
+
+    // Trabajo del hilo de carga: un archivo de chunk o un asset
+    typedef struct {
+        StreamChunk* chunk;
+        StreamAsset* asset;
+    } StreamJob;
+
+    static long long ChunkKey(int x, int z) { return (long long)(((unsigned long long)(unsigned int)x << 32) | (unsigned int)z); }
+    static std::string AssetKey(const ChunkModelEntry& entry) { return entry.model + "|" + entry.texture; }
+
+    void WorkerLoop();
+    void LoadChunkData(StreamChunk* chunk);
+    static void LoadAssetData(StreamAsset* asset);
+    static void FreeAssetData(StreamAsset* asset);
+    void CancelJob(StreamJob job);
+
+    void RequestChunk(int x, int z);
+    void UnloadChunk(StreamChunk* chunk);
+    void CollectParsed();
+    bool FinalizeStep(StreamChunk* chunk);
+    StreamAsset* AcquireAsset(const ChunkModelEntry& entry);
+    void UploadAsset(StreamAsset* asset);
+    void ReleaseAsset(StreamAsset* asset);
+    size_t ReleasableBytes(const StreamChunk* chunk) const;
+    float ChunkDistance(const StreamChunk* chunk, Vector3 position) const;
+
+    std::string directory;
+    WorldStreamConfig config = { 0 };
+    SceneIndex* scene = NULL;
+
+    std::unordered_map<long long, StreamChunk*> chunks;     // Solo hilo principal
+    std::deque<StreamChunk*> finalizing;
+    std::deque<StreamAsset*> uploading;
+    std::vector<StreamAsset*> retired;
+    std::unordered_map<std::string, StreamAsset*> assets;   // Solo hilo principal
+
+    std::thread worker;
+    std::deque<StreamJob> pending;
+    std::deque<StreamJob> parsed;
+    std::mutex mutex;
+    std::condition_variable chunkReady;
+    bool stopping = false;
+
+    Vector3 lastPosition = { 0 };
+    Vector3 velocity = { 0 };
+    bool hasLastPosition = false;
+    int lastCameraX = 0;
+    int lastCameraZ = 0;
+    bool memoryLimited = false;     // No cargar mas hasta que la camara cambie de chunk
+    WorldStreamStats stats = { 0 };
+};
+
+#endif
@@ -9,3 +9,19 @@ function DrawX(dt)
 	SimpleDraw.Clear(20,20,20)
 	simpledraw.DrawCircle(100,50,28, 255, 29, 141, 0)
 end
+
+-- Particulas nativas: el emisor se configura una vez y Draw solo lo dispara
+local particles = ParticleSystem.getInstance()
+local fountain = particles:CreateEmitter{
+	x = 100, y = 700, vy = -300, spreadx = 60, spready = 60,
+	gravityy = 250, lifetime = 2.5, size = 3, capacity = 20000,
+	startColor = SimpleDraw.Color(255, 200, 80), endColor = SimpleDraw.Color(255, 40, 20, 0)
+}
+local pending = 0
+
+function Draw(dt)
+	pending = pending + 6000 * dt
+	local count = math.floor(pending)
+	particles:Emit(fountain, count)
+	pending = pending - count
+end
@@ -0,0 +1,116 @@
+#include "bunnymark.h"
+#include "raylib.h"
+#include "sprite_batch.h"
+#include "resource_dir.h"
+#include <stdio.h>
+#include <vector>
+
+#define BUNNY_START_COUNT 1000
+#define BUNNY_GROWTH 1.25f
+#define BUNNY_SAMPLE_FRAMES 60
+#define BUNNY_TARGET_FRAME_TIME (1.0f / 60.0f)
+
+typedef struct {
+    Vector2 position;
+    Vector2 speed;
+    Color color;
+} Bunny;
+
+static void SpawnBunnies(std::vector<Bunny>& bunnies, int count)
+{
+    while ((int)bunnies.size() < count)
+    {
+        Bunny b;
+        b.position = { (float)GetRandomValue(0, GetScreenWidth()), (float)GetRandomValue(0, GetScreenHeight()) };
+        b.speed = { GetRandomValue(-250, 250) / 60.0f, GetRandomValue(-250, 250) / 60.0f };
+        b.color = { (unsigned char)GetRandomValue(50, 240), (unsigned char)GetRandomValue(80, 240), (unsigned char)GetRandomValue(100, 240), 255 };
+        bunnies.push_back(b);
+    }
+}
+
+static void UpdateBunnies(std::vector<Bunny>& bunnies, float width, float height)
+{
+    for (size_t i = 0; i < bunnies.size(); i++)
+    {
+        Bunny& b = bunnies[i];
+        b.position.x += b.speed.x;
+        b.position.y += b.speed.y;
+        if (b.position.x + width / 2 > GetScreenWidth() || b.position.x + width / 2 < 0) b.speed.x *= -1;
+        if (b.position.y + height / 2 > GetScreenHeight() || b.position.y + height / 2 < 40) b.speed.y *= -1;
+    }
+}
+
+// Devuelve el mayor numero de sprites que mantuvo 60 FPS
+static int MeasureMaxBunnies(bool batched, Texture2D texture, const SpriteAtlas* atlas, int sprite)
+{
+    std::vector<Bunny> bunnies;
+    SpriteBatch batch;
+    int count = BUNNY_START_COUNT;
+    int best = 0;
+
+    while (!WindowShouldClose())
+    {
+        SpawnBunnies(bunnies, count);
+
+        double start = GetTime();
+        for (int frame = 0; frame < BUNNY_SAMPLE_FRAMES; frame++)
+        {
+            UpdateBunnies(bunnies, (float)texture.width, (float)texture.height);
+
+            BeginDrawing();
+            ClearBackground(RAYWHITE);
+            if (batched)
+            {
+                batch.Begin(atlas);
+                for (size_t i = 0; i < bunnies.size(); i++) batch.Draw(sprite, bunnies[i].position, 1.0f, bunnies[i].color);
+                batch.End();
+            }
+            else
+            {
+                for (size_t i = 0; i < bunnies.size(); i++)
+                    DrawTexture(texture, (int)bunnies[i].position.x, (int)bunnies[i].position.y, bunnies[i].color);
+            }
+            DrawRectangle(0, 0, GetScreenWidth(), 40, BLACK);
+            DrawText(TextFormat("%s  sprites: %d", batched ? "SpriteBatch" : "DrawTexture", (int)bunnies.size()), 120, 10, 20, GREEN);
+            DrawFPS(10, 10);
+            EndDrawing();
+        }
+        float frameTime = (float)((GetTime() - start) / BUNNY_SAMPLE_FRAMES);
+
+        printf("[BUNNYMARK] %s: %d sprites, %.2f ms/frame\n", batched ? "batch" : "drawtexture", count, frameTime * 1000.0f);
+        if (frameTime > BUNNY_TARGET_FRAME_TIME) break;
+
+        best = count;
+        count = (int)(count * BUNNY_GROWTH);
+    }
+
+    batch.Unload();
+    return best;
+}
+
+int RunBunnymark(void)
+{
+    // Sin vsync ni limite de FPS para medir el coste real
+    InitWindow(1280, 720, "Game Engine - bunnymark");
+    SetTargetFPS(0);
+    SearchAndSetResourceDir("resources");
+
+    Texture2D texture = LoadTexture("wabbit_alpha.png");
+    SpriteAtlas atlas;
+    int sprite = atlas.AddImage("wabbit_alpha.png");
+    if (texture.id == 0 || sprite < 0 || !atlas.Build())
+    {
+        printf("[BUNNYMARK] No se pudo cargar wabbit_alpha.png\n");
+        CloseWindow();
+        return 1;
+    }
+
+    int before = MeasureMaxBunnies(false, texture, &atlas, sprite);
+    int after = MeasureMaxBunnies(true, texture, &atlas, sprite);
+    printf("[BUNNYMARK] Sprites/frame a 60 FPS: DrawTexture=%d  SpriteBatch=%d\n", before, after);
+
+    atlas.Unload();
+    UnloadTexture(texture);
+    CloseWindow();
+    return 0;
+}
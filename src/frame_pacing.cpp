@@ -0,0 +1,113 @@
+#include "frame_pacing.h"
+#include "rlgl.h"
+#include <math.h>
+
+#define PACING_SCALE_STEP 0.05f         // La escala se redondea a este paso
+#define PACING_MAX_CHANGE 0.1f          // Cambio maximo por ajuste
+#define PACING_COOLDOWN_FRAMES 10       // Frames entre ajustes, para ver el efecto del anterior
+#define PACING_PROBE_FRAMES 120         // Frames estables antes de probar a subir
+#define PACING_SMOOTHING 0.1f           // Media movil exponencial del tiempo de render
+#define PACING_OVER_BUDGET 1.02f
+#define PACING_UNDER_BUDGET 0.85f
+
+void FramePacer::Init(const PacingConfig& pacingConfig)
+{
+    config = pacingConfig;
+    if (config.targetFps <= 0) config.targetFps = 60.0f;
+    if (config.maxScale <= 0 || config.maxScale > 1.0f) config.maxScale = 1.0f;
+    if (config.minScale <= 0 || config.minScale > config.maxScale) config.minScale = config.maxScale;
+
+    scale = config.maxScale;
+    averageMs = 1000.0f / config.targetFps;
+    if (config.enabled) Allocate(GetScreenWidth(), GetScreenHeight());
+}
+
+void FramePacer::Allocate(int width, int height)
+{
+    if (target.id != 0) UnloadRenderTexture(target);
+
+    nativeWidth = width;
+    nativeHeight = height;
+    target = LoadRenderTexture((int)(width * config.maxScale), (int)(height * config.maxScale));
+    SetTextureFilter(target.texture, TEXTURE_FILTER_BILINEAR);
+}
+
+void FramePacer::Unload()
+{
+    if (target.id != 0) UnloadRenderTexture(target);
+    target = RenderTexture2D{ 0 };
+}
+
+void FramePacer::Begin3D()
+{
+    if (!config.enabled) return;
+    if (GetScreenWidth() != nativeWidth || GetScreenHeight() != nativeHeight) Allocate(GetScreenWidth(), GetScreenHeight());
+
+    viewWidth = (int)(nativeWidth * scale);
+    viewHeight = (int)(nativeHeight * scale);
+
+    BeginTextureMode(target);
+    ClearBackground(BLANK);
+
+    // Misma proporcion que la textura: BeginMode3D calcula el aspect con el
+    // tamano del framebuffer y sigue siendo correcto
+    rlViewport(0, 0, viewWidth, viewHeight);
+}
+
+void FramePacer::End3D()
+{
+    if (!config.enabled) return;
+    EndTextureMode();
+
+    // En OpenGL el viewport queda abajo a la izquierda; la altura negativa voltea la imagen
+    Rectangle source = { 0, 0, (float)viewWidth, -(float)viewHeight };
+    Rectangle dest = { 0, 0, (float)GetScreenWidth(), (float)GetScreenHeight() };
+    DrawTexturePro(target.texture, source, dest, Vector2{ 0, 0 }, 0.0f, WHITE);
+}
+
+void FramePacer::Update(float renderTime)
+{
+    float renderMs = renderTime * 1000.0f;
+    averageMs += (renderMs - averageMs) * PACING_SMOOTHING;
+    if (!config.enabled) return;
+
+    if (cooldown > 0)
+    {
+        cooldown--;
+        return;
+    }
+
+    // El coste del pase 3D va con el numero de pixeles, es decir con scale^2
+    float budgetMs = 1000.0f / config.targetFps;
+    float desired = scale;
+    if (averageMs > budgetMs * PACING_OVER_BUDGET)
+    {
+        desired = fminf(scale * sqrtf(budgetMs / averageMs), scale - PACING_SCALE_STEP);
+        stableFrames = 0;
+    }
+    else if (averageMs < budgetMs * PACING_UNDER_BUDGET)
+    {
+        desired = fmaxf(scale * sqrtf(budgetMs / averageMs), scale + PACING_SCALE_STEP);
+        stableFrames = 0;
+    }
+    else if (scale < config.maxScale && ++stableFrames >= PACING_PROBE_FRAMES)
+    {
+        // Con vsync el tiempo de render (incluye el intercambio de buffers)
+        // nunca baja del presupuesto: de vez en cuando se prueba a subir y,
+        // si no cabe, el control vuelve a bajar
+        desired = scale + PACING_SCALE_STEP;
+        stableFrames = 0;
+    }
+
+    if (desired > scale + PACING_MAX_CHANGE) desired = scale + PACING_MAX_CHANGE;
+    if (desired < scale - PACING_MAX_CHANGE) desired = scale - PACING_MAX_CHANGE;
+    desired = roundf(desired / PACING_SCALE_STEP) * PACING_SCALE_STEP;
+    if (desired > config.maxScale) desired = config.maxScale;
+    if (desired < config.minScale) desired = config.minScale;
+
+    if (desired != scale)
+    {
+        scale = desired;
+        cooldown = PACING_COOLDOWN_FRAMES;
+    }
+}
@@ -0,0 +1,119 @@
+#include "frame_pipeline.h"
+
+// -----------------------------------------------------------------------------
+// Grabacion de comandos de Lua
+// -----------------------------------------------------------------------------
+static thread_local std::vector<LuaDrawCommand>* luaDrawTarget = NULL;
+
+void SetLuaDrawTarget(std::vector<LuaDrawCommand>* target)
+{
+    luaDrawTarget = target;
+}
+
+static void Record(LuaDrawType type, float a, float b, float c, float d, Color color)
+{
+    luaDrawTarget->push_back(LuaDrawCommand{ type, { a, b, c, d }, color });
+}
+
+void LuaRecordClear(Color color)
+{
+    if (luaDrawTarget == NULL) ClearBackground(color);
+    else Record(LUA_DRAW_CLEAR, 0, 0, 0, 0, color);
+}
+
+void LuaRecordCircle(int centerX, int centerY, float radius, Color color)
+{
+    if (luaDrawTarget == NULL) DrawCircle(centerX, centerY, radius, color);
+    else Record(LUA_DRAW_CIRCLE, (float)centerX, (float)centerY, radius, 0, color);
+}
+
+void LuaRecordRect(int posX, int posY, int width, int height, Color color)
+{
+    if (luaDrawTarget == NULL) DrawRectangle(posX, posY, width, height, color);
+    else Record(LUA_DRAW_RECT, (float)posX, (float)posY, (float)width, (float)height, color);
+}
+
+void LuaRecordLine(int startX, int startY, int endX, int endY, Color color)
+{
+    if (luaDrawTarget == NULL) DrawLine(startX, startY, endX, endY, color);
+    else Record(LUA_DRAW_LINE, (float)startX, (float)startY, (float)endX, (float)endY, color);
+}
+
+void DrawLuaCommands(const std::vector<LuaDrawCommand>& commands)
+{
+    for (size_t i = 0; i < commands.size(); i++)
+    {
+        const LuaDrawCommand& cmd = commands[i];
+        const float* v = cmd.values;
+        switch (cmd.type)
+        {
+        case LUA_DRAW_CLEAR: ClearBackground(cmd.color); break;
+        case LUA_DRAW_CIRCLE: DrawCircle((int)v[0], (int)v[1], v[2], cmd.color); break;
+        case LUA_DRAW_RECT: DrawRectangle((int)v[0], (int)v[1], (int)v[2], (int)v[3], cmd.color); break;
+        case LUA_DRAW_LINE: DrawLine((int)v[0], (int)v[1], (int)v[2], (int)v[3], cmd.color); break;
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// FramePipeline
+// -----------------------------------------------------------------------------
+void FramePipeline::Start(SimulateFn simulateFn)
+{
+    simulate = simulateFn;
+    stopping = false;
+    thread = std::thread(&FramePipeline::ThreadLoop, this);
+}
+
+void FramePipeline::Stop()
+{
+    if (!thread.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        workReady.notify_one();
+    }
+    thread.join();
+}
+
+void FramePipeline::Submit(const SimulationInput& input)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    pending = input;
+    hasWork = true;
+    workReady.notify_one();
+}
+
+FramePacket* FramePipeline::Wait()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    workDone.wait(lock, [this] { return !hasWork && !busy; });
+
+    // El paquete terminado pasa al render y la siguiente simulacion usa el otro
+    int ready = writeIndex;
+    writeIndex = 1 - writeIndex;
+    return &packets[ready];
+}
+
+void FramePipeline::ThreadLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+        // Si hay trabajo pendiente se termina antes de salir
+        workReady.wait(lock, [this] { return stopping || hasWork; });
+        if (!hasWork) return;
+
+        SimulationInput input = pending;
+        FramePacket& packet = packets[writeIndex];
+        hasWork = false;
+        busy = true;
+        lock.unlock();
+
+        simulate(input, packet);
+
+        lock.lock();
+        busy = false;
+        workDone.notify_all();
+    }
+}
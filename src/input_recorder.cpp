@@ -0,0 +1,208 @@
+#include "input_recorder.h"
+#include <stdint.h>
+#include <string.h>
+
+#define INPUT_STREAM_MAGIC "GEIN"
+#define INPUT_STREAM_VERSION 1
+
+#define INPUT_FLAG_MOUSE 0x01
+#define INPUT_FLAG_WHEEL 0x02
+#define INPUT_FLAG_DROPS 0x04
+
+// Velocidades de la camara libre, por segundo para que dependan del dt grabado
+#define CAMERA_MOVE_SPEED 5.4f
+#define CAMERA_ROTATION_SPEED 100.0f            // Grados por segundo con las flechas
+#define CAMERA_MOUSE_SENSITIVITY 0.17f          // Grados por pixel
+#define CAMERA_PAN_SPEED 12.0f                  // Con el boton central; 0.2 por frame a 60 fps, como raylib
+
+static const int INPUT_KEYS[INPUT_MOUSE_MIDDLE] = {
+    KEY_W, KEY_S, KEY_A, KEY_D, KEY_SPACE, KEY_Q, KEY_E, KEY_LEFT_CONTROL, KEY_UP, KEY_DOWN, KEY_LEFT, KEY_RIGHT
+};
+
+void UpdateCameraFromInput(Camera3D* camera, const InputFrame* frame)
+{
+    float move = CAMERA_MOVE_SPEED * frame->dt;
+    float turn = CAMERA_ROTATION_SPEED * frame->dt;
+
+    Vector3 movement = { 0 };
+    if (IsInputDown(frame, INPUT_KEY_W)) movement.x += move;
+    if (IsInputDown(frame, INPUT_KEY_S)) movement.x -= move;
+    if (IsInputDown(frame, INPUT_KEY_D)) movement.y += move;
+    if (IsInputDown(frame, INPUT_KEY_A)) movement.y -= move;
+    if (IsInputDown(frame, INPUT_KEY_SPACE)) movement.z += move;
+    if (IsInputDown(frame, INPUT_KEY_LEFT_CONTROL)) movement.z -= move;
+
+    // Con el boton central el raton panea en vez de girar, igual que CAMERA_FREE
+    Vector3 rotation = { 0 };
+    if (IsInputDown(frame, INPUT_MOUSE_MIDDLE))
+    {
+        float pan = CAMERA_PAN_SPEED * frame->dt;
+        if (frame->mouseDelta.x > 0) movement.y += pan;
+        if (frame->mouseDelta.x < 0) movement.y -= pan;
+        if (frame->mouseDelta.y > 0) movement.z -= pan;
+        if (frame->mouseDelta.y < 0) movement.z += pan;
+    }
+    else
+    {
+        rotation.x = frame->mouseDelta.x * CAMERA_MOUSE_SENSITIVITY;
+        rotation.y = frame->mouseDelta.y * CAMERA_MOUSE_SENSITIVITY;
+    }
+    if (IsInputDown(frame, INPUT_KEY_RIGHT)) rotation.x += turn;
+    if (IsInputDown(frame, INPUT_KEY_LEFT)) rotation.x -= turn;
+    if (IsInputDown(frame, INPUT_KEY_DOWN)) rotation.y += turn;
+    if (IsInputDown(frame, INPUT_KEY_UP)) rotation.y -= turn;
+    if (IsInputDown(frame, INPUT_KEY_E)) rotation.z += turn;
+    if (IsInputDown(frame, INPUT_KEY_Q)) rotation.z -= turn;
+
+    UpdateCameraPro(camera, movement, rotation, -frame->mouseWheel);
+}
+
+// -----------------------------------------------------------------------------
+// InputRecorder
+// -----------------------------------------------------------------------------
+bool InputRecorder::StartRecording(const char* fileName)
+{
+    Stop();
+    file = fopen(fileName, "wb");
+    if (file == NULL) return false;
+
+    uint32_t version = INPUT_STREAM_VERSION;
+    fwrite(INPUT_STREAM_MAGIC, 1, 4, file);
+    fwrite(&version, sizeof(version), 1, file);
+    recording = true;
+    return true;
+}
+
+bool InputRecorder::StartReplay(const char* fileName)
+{
+    Stop();
+    file = fopen(fileName, "rb");
+    if (file == NULL) return false;
+
+    char magic[4];
+    uint32_t version = 0;
+    if (fread(magic, 1, 4, file) != 4 || memcmp(magic, INPUT_STREAM_MAGIC, 4) != 0 ||
+        fread(&version, sizeof(version), 1, file) != 1 || version != INPUT_STREAM_VERSION)
+    {
+        fclose(file);
+        file = NULL;
+        return false;
+    }
+
+    replaying = true;
+    finished = false;
+    return true;
+}
+
+void InputRecorder::Stop()
+{
+    if (file != NULL) fclose(file);
+    file = NULL;
+    recording = false;
+    replaying = false;
+}
+
+void InputRecorder::Poll(InputFrame* frame)
+{
+    if (replaying)
+    {
+        if (!ReadFrame(frame))
+        {
+            // Fin de la repeticion: frame vacio con el ultimo dt
+            frame->keysDown = 0;
+            frame->keysPressed = 0;
+            frame->mouseDelta = { 0, 0 };
+            frame->mouseWheel = 0;
+            frame->droppedFiles.clear();
+            finished = true;
+            return;
+        }
+    }
+    else
+    {
+        PollLive(frame);
+        if (recording) WriteFrame(frame);
+    }
+    frameCount++;
+}
+
+void InputRecorder::PollLive(InputFrame* frame)
+{
+    frame->dt = GetFrameTime();
+    frame->keysDown = 0;
+    frame->keysPressed = 0;
+    for (int i = 0; i < INPUT_MOUSE_MIDDLE; i++)
+    {
+        if (IsKeyDown(INPUT_KEYS[i])) frame->keysDown |= (unsigned short)(1 << i);
+        if (IsKeyPressed(INPUT_KEYS[i])) frame->keysPressed |= (unsigned short)(1 << i);
+    }
+    if (IsMouseButtonDown(MOUSE_BUTTON_MIDDLE)) frame->keysDown |= (unsigned short)(1 << INPUT_MOUSE_MIDDLE);
+    if (IsMouseButtonPressed(MOUSE_BUTTON_MIDDLE)) frame->keysPressed |= (unsigned short)(1 << INPUT_MOUSE_MIDDLE);
+    frame->mouseDelta = GetMouseDelta();
+    frame->mouseWheel = GetMouseWheelMove();
+
+    frame->droppedFiles.clear();
+    if (IsFileDropped())
+    {
+        FilePathList droppedFiles = LoadDroppedFiles();
+        for (unsigned int i = 0; i < droppedFiles.count; i++) frame->droppedFiles.push_back(droppedFiles.paths[i]);
+        UnloadDroppedFiles(droppedFiles);
+    }
+}
+
+void InputRecorder::WriteFrame(const InputFrame* frame)
+{
+    uint8_t flags = 0;
+    if (frame->mouseDelta.x != 0 || frame->mouseDelta.y != 0) flags |= INPUT_FLAG_MOUSE;
+    if (frame->mouseWheel != 0) flags |= INPUT_FLAG_WHEEL;
+    if (!frame->droppedFiles.empty()) flags |= INPUT_FLAG_DROPS;
+
+    fwrite(&frame->dt, sizeof(float), 1, file);
+    fwrite(&frame->keysDown, sizeof(uint16_t), 1, file);
+    fwrite(&frame->keysPressed, sizeof(uint16_t), 1, file);
+    fwrite(&flags, sizeof(flags), 1, file);
+
+    if (flags & INPUT_FLAG_MOUSE) fwrite(&frame->mouseDelta, sizeof(float), 2, file);
+    if (flags & INPUT_FLAG_WHEEL) fwrite(&frame->mouseWheel, sizeof(float), 1, file);
+    if (flags & INPUT_FLAG_DROPS)
+    {
+        uint8_t count = (uint8_t)frame->droppedFiles.size();
+        fwrite(&count, sizeof(count), 1, file);
+        for (int i = 0; i < count; i++)
+        {
+            uint16_t length = (uint16_t)frame->droppedFiles[i].size();
+            fwrite(&length, sizeof(length), 1, file);
+            fwrite(frame->droppedFiles[i].data(), 1, length, file);
+        }
+    }
+}
+
+bool InputRecorder::ReadFrame(InputFrame* frame)
+{
+    uint8_t flags = 0;
+    if (fread(&frame->dt, sizeof(float), 1, file) != 1) return false;
+    if (fread(&frame->keysDown, sizeof(uint16_t), 1, file) != 1) return false;
+    if (fread(&frame->keysPressed, sizeof(uint16_t), 1, file) != 1) return false;
+    if (fread(&flags, sizeof(flags), 1, file) != 1) return false;
+
+    frame->mouseDelta = { 0, 0 };
+    frame->mouseWheel = 0;
+    frame->droppedFiles.clear();
+
+    if ((flags & INPUT_FLAG_MOUSE) && fread(&frame->mouseDelta, sizeof(float), 2, file) != 2) return false;
+    if ((flags & INPUT_FLAG_WHEEL) && fread(&frame->mouseWheel, sizeof(float), 1, file) != 1) return false;
+    if (flags & INPUT_FLAG_DROPS)
+    {
+        uint8_t count = 0;
+        if (fread(&count, sizeof(count), 1, file) != 1) return false;
+        for (int i = 0; i < count; i++)
+        {
+            uint16_t length = 0;
+            if (fread(&length, sizeof(length), 1, file) != 1) return false;
+            std::string path(length, '\0');
+            if (length > 0 && fread(&path[0], 1, length, file) != length) return false;
+            frame->droppedFiles.push_back(path);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,89 @@
+#include "lua_bench.h"
+#include "lua_bind.h"
+#include <chrono>
+#include <stdio.h>
+
+#define LUA_BENCH_CALLS 1000000
+// Las variantes se alternan varias veces y se queda el mejor tiempo de cada
+// una: una sola pasada seguida depende demasiado de la carga de la maquina
+#define LUA_BENCH_ROUNDS 7
+
+static volatile float benchSink;
+
+static void BenchCircle(int x, int y, float radius, Color color)
+{
+    benchSink = benchSink + x + y + radius + color.a;
+}
+
+// Misma forma que el antiguo drawCircle de main.cpp
+static int BenchCircleHandWritten(lua_State* L)
+{
+    float x = (float)lua_tonumber(L, 1);
+    float y = (float)lua_tonumber(L, 2);
+    float radius = (float)lua_tonumber(L, 3);
+    int r = (float)lua_tonumber(L, 4);
+    int g = (float)lua_tonumber(L, 5);
+    int b = (float)lua_tonumber(L, 6);
+    int a = (float)lua_tonumber(L, 7);
+    Color c = { (unsigned char)r, (unsigned char)g, (unsigned char)b, (unsigned char)a };
+    BenchCircle((int)x, (int)y, radius, c);
+    return 0;
+}
+
+static double TimeScript(lua_State* L, const char* script)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    if (luaL_dostring(L, script))
+    {
+        printf("[LUABENCH] Error: %s\n", lua_tostring(L, -1));
+        lua_pop(L, 1);
+        return 0.0;
+    }
+    std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+    return elapsed.count();
+}
+
+int RunLuaBindingBenchmark(void)
+{
+    lua_State* L = luaL_newstate();
+    luaL_openlibs(L);
+    LuaRegisterValueTypes(L);
+
+    lua_pushcfunction(L, BenchCircleHandWritten);
+    lua_setglobal(L, "HandWritten");
+    lua_pushcfunction(L, LuaBind<BenchCircle>);
+    lua_setglobal(L, "Generated");
+    lua_pushcfunction(L, LuaConstruct<Color>);
+    lua_setglobal(L, "MakeColor");
+
+    char script[256];
+    const char* variants[3][2] = {
+        { "hand-written, numeros sueltos", "HandWritten(100, 50, 28, 255, 29, 141, 255)" },
+        { "LuaBind, numeros sueltos", "Generated(100, 50, 28, 255, 29, 141, 255)" },
+        { "LuaBind, Color userdata", "Generated(100, 50, 28, c)" },
+    };
+
+    double nanoseconds[3] = { 0.0, 0.0, 0.0 };
+    for (int round = 0; round < LUA_BENCH_ROUNDS; round++)
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            snprintf(script, sizeof(script), "local c = MakeColor(255, 29, 141, 255) for i = 1, %d do %s end", LUA_BENCH_CALLS, variants[i][1]);
+            double ns = TimeScript(L, script) * 1e9 / LUA_BENCH_CALLS;
+            if (round == 0 || ns < nanoseconds[i]) nanoseconds[i] = ns;
+        }
+    }
+    for (int i = 0; i < 3; i++) printf("[LUABENCH] %-32s %8.2f ns/llamada\n", variants[i][0], nanoseconds[i]);
+
+    // Relacion con el binding a mano: <= 1.00 significa que el generado no es
+    // mas lento; hasta 1.05 se cuenta como ruido de medida
+    if (nanoseconds[0] > 0.0)
+    {
+        printf("[LUABENCH] LuaBind / hand-written: %.2f (numeros sueltos), %.2f (Color userdata) -> %s\n",
+            nanoseconds[1] / nanoseconds[0], nanoseconds[2] / nanoseconds[0],
+            nanoseconds[1] <= nanoseconds[0] * 1.05 ? "OK" : "mas lento");
+    }
+
+    lua_close(L);
+    return 0;
+}
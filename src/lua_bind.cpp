@@ -0,0 +1,108 @@
+#include "lua_bind.h"
+#include <string.h>
+
+// -----------------------------------------------------------------------------
+// Acceso a campos de los tipos por valor: v.x, c.r, camera.position...
+// -----------------------------------------------------------------------------
+typedef enum {
+    FIELD_FLOAT,
+    FIELD_UCHAR,
+    FIELD_INT,
+    FIELD_VECTOR3
+} FieldKind;
+
+typedef struct {
+    const char* name;
+    size_t offset;
+    FieldKind kind;
+} FieldInfo;
+
+static const FieldInfo VECTOR2_FIELDS[] = {
+    { "x", offsetof(Vector2, x), FIELD_FLOAT },
+    { "y", offsetof(Vector2, y), FIELD_FLOAT },
+    { NULL, 0, FIELD_FLOAT }
+};
+
+static const FieldInfo VECTOR3_FIELDS[] = {
+    { "x", offsetof(Vector3, x), FIELD_FLOAT },
+    { "y", offsetof(Vector3, y), FIELD_FLOAT },
+    { "z", offsetof(Vector3, z), FIELD_FLOAT },
+    { NULL, 0, FIELD_FLOAT }
+};
+
+static const FieldInfo COLOR_FIELDS[] = {
+    { "r", offsetof(Color, r), FIELD_UCHAR },
+    { "g", offsetof(Color, g), FIELD_UCHAR },
+    { "b", offsetof(Color, b), FIELD_UCHAR },
+    { "a", offsetof(Color, a), FIELD_UCHAR },
+    { NULL, 0, FIELD_FLOAT }
+};
+
+static const FieldInfo CAMERA3D_FIELDS[] = {
+    { "position", offsetof(Camera3D, position), FIELD_VECTOR3 },
+    { "target", offsetof(Camera3D, target), FIELD_VECTOR3 },
+    { "up", offsetof(Camera3D, up), FIELD_VECTOR3 },
+    { "fovy", offsetof(Camera3D, fovy), FIELD_FLOAT },
+    { "projection", offsetof(Camera3D, projection), FIELD_INT },
+    { NULL, 0, FIELD_FLOAT }
+};
+
+static const FieldInfo* FindField(lua_State* L)
+{
+    // La tabla de campos va como upvalue de __index/__newindex
+    const FieldInfo* fields = (const FieldInfo*)lua_touserdata(L, lua_upvalueindex(1));
+    const char* key = luaL_checkstring(L, 2);
+    for (int i = 0; fields[i].name != NULL; i++)
+        if (strcmp(fields[i].name, key) == 0) return &fields[i];
+    luaL_error(L, "campo desconocido '%s'", key);
+    return NULL;
+}
+
+static int FieldIndex(lua_State* L)
+{
+    const FieldInfo* field = FindField(L);
+    unsigned char* data = (unsigned char*)lua_touserdata(L, 1) + field->offset;
+    switch (field->kind)
+    {
+    case FIELD_FLOAT: lua_pushnumber(L, *(float*)data); break;
+    case FIELD_UCHAR: lua_pushinteger(L, *data); break;
+    case FIELD_INT: lua_pushinteger(L, *(int*)data); break;
+    case FIELD_VECTOR3: LuaValue<Vector3>::Push(L, *(Vector3*)data); break;
+    }
+    return 1;
+}
+
+static int FieldNewIndex(lua_State* L)
+{
+    const FieldInfo* field = FindField(L);
+    unsigned char* data = (unsigned char*)lua_touserdata(L, 1) + field->offset;
+    int idx = 3;
+    switch (field->kind)
+    {
+    case FIELD_FLOAT: *(float*)data = (float)luaL_checknumber(L, 3); break;
+    case FIELD_UCHAR: *data = LuaValue<Color>::Channel(L, 3, luaL_checkinteger(L, 3)); break;    // Solo Color tiene campos de un byte
+    case FIELD_INT: *(int*)data = (int)luaL_checkinteger(L, 3); break;
+    case FIELD_VECTOR3: *(Vector3*)data = LuaValue<Vector3>::Get(L, idx); break;
+    }
+    return 0;
+}
+
+static void RegisterValueType(lua_State* L, const char* name, const FieldInfo* fields)
+{
+    luaL_newmetatable(L, name);
+    lua_pushlightuserdata(L, (void*)fields);
+    lua_pushcclosure(L, FieldIndex, 1);
+    lua_setfield(L, -2, "__index");
+    lua_pushlightuserdata(L, (void*)fields);
+    lua_pushcclosure(L, FieldNewIndex, 1);
+    lua_setfield(L, -2, "__newindex");
+    lua_pop(L, 1);
+}
+
+void LuaRegisterValueTypes(lua_State* L)
+{
+    RegisterValueType(L, LuaUserType<Vector2>::name, VECTOR2_FIELDS);
+    RegisterValueType(L, LuaUserType<Vector3>::name, VECTOR3_FIELDS);
+    RegisterValueType(L, LuaUserType<Color>::name, COLOR_FIELDS);
+    RegisterValueType(L, LuaUserType<Camera3D>::name, CAMERA3D_FIELDS);
+}
@@ -17,6 +17,17 @@ by Jeffery Myers is marked with CC0 1.0.
 #include   "..\build\build_files\Component.h"
 #include <Vector>
 #include "lua.hpp"
+#include "scene_index.h"
+#include "sprite_batch.h"
+#include "bunnymark.h"
+#include "input_recorder.h"
+#include "lua_bind.h"
+#include "lua_bench.h"
+#include "frame_pipeline.h"
+#include "frame_pacing.h"
+#include "particle_system.h"
+#include "particle_bench.h"
+#include "world_streaming.h"
 
 
 #include "resource_dir.h" // utility header for SearchAndSetResourceDir
@@ -69,77 +80,120 @@ void luaDraw(lua_State* L, float dt)
     }
 }
 
-int Clear(lua_State* L) 
+//para crear la biblioteca de funciones en lua
+// Los bindings los genera LuaBind<> a partir de la firma de cada funcion. Las
+// funciones de dibujo se graban en el paquete del frame (ver frame_pipeline.h)
+int lua_mymodule(lua_State* L)
 {
-    int r = (float)lua_tonumber(L, 1);
-    int g = (float)lua_tonumber(L, 2);
-    int b = (float)lua_tonumber(L, 3);
-	int a = (float)lua_tonumber(L, 4);
-
-	Color c = { r, g, b, a };
+    static const luaL_Reg myModule[] =
+    {
+    { "Clear", LuaBind<LuaRecordClear> },
+    { "DrawCircle", LuaBind<LuaRecordCircle> },
+    { "DrawRect", LuaBind<LuaRecordRect> },
+    { "DrawLine", LuaBind<LuaRecordLine> },
+    { "Color", LuaConstruct<Color> },
+    { "Vector2", LuaConstruct<Vector2> },
+    { "Vector3", LuaConstruct<Vector3> },
+    { "Camera3D", LuaConstruct<Camera3D> },
+    { NULL, NULL }
+    };
+    luaL_newlib(L, myModule);
+    return 1;
+}
 
-	ClearBackground(c);
+// Configuracion de un emisor desde una tabla de Lua:
+//   { x, y, vx, vy, spreadx, spready, gravityx, gravityy, drag, lifetime,
+//     size, capacity, startColor, endColor }
+// Los campos que falten toman el valor de DefaultEmitterConfig()
+template <>
+struct LuaValue<EmitterConfig> {
+    static float Field(lua_State* L, int table, const char* name, float fallback)
+    {
+        lua_getfield(L, table, name);
+        float value = lua_isnumber(L, -1) ? (float)lua_tonumber(L, -1) : fallback;
+        lua_pop(L, 1);
+        return value;
+    }
 
-	return 0;
-}
+    static Color ColorField(lua_State* L, int table, const char* name, Color fallback)
+    {
+        lua_getfield(L, table, name);
+        Color* color = LuaValue<Color>::Test(L, -1);
+        Color value = color != NULL ? *color : fallback;
+        lua_pop(L, 1);
+        return value;
+    }
 
-int drawCircle(lua_State* L)
-{
-    float x = (float)lua_tonumber(L, 1);
-    float y = (float)lua_tonumber(L, 2);
-    float radius = (float)lua_tonumber(L, 3);
-    int r = (float)lua_tonumber(L, 4);
-    int g = (float)lua_tonumber(L, 5);
-    int b = (float)lua_tonumber(L, 6);
-    int a = (float)lua_tonumber(L, 7);
-    Color c = { r, g, b, a };
-    DrawCircle(x, y, radius, c);
-    return 0;
-}
+    static EmitterConfig Get(lua_State* L, int& idx)
+    {
+        luaL_checktype(L, idx, LUA_TTABLE);
+        EmitterConfig c = DefaultEmitterConfig();
+        c.position.x = Field(L, idx, "x", c.position.x);
+        c.position.y = Field(L, idx, "y", c.position.y);
+        c.velocity.x = Field(L, idx, "vx", c.velocity.x);
+        c.velocity.y = Field(L, idx, "vy", c.velocity.y);
+        c.spread.x = Field(L, idx, "spreadx", c.spread.x);
+        c.spread.y = Field(L, idx, "spready", c.spread.y);
+        c.gravity.x = Field(L, idx, "gravityx", c.gravity.x);
+        c.gravity.y = Field(L, idx, "gravityy", c.gravity.y);
+        c.drag = Field(L, idx, "drag", c.drag);
+        c.lifetime = Field(L, idx, "lifetime", c.lifetime);
+        c.size = Field(L, idx, "size", c.size);
+        c.capacity = (int)Field(L, idx, "capacity", (float)c.capacity);
+        c.startColor = ColorField(L, idx, "startColor", c.startColor);
+        c.endColor = ColorField(L, idx, "endColor", c.endColor);
+        idx++;
+        return c;
+    }
+};
 
-int drawRect(lua_State* L)
+// Clases del motor accesibles desde Lua: AudioManager.getInstance():Play(),
+// GameObject.Spawn(pos, size, "nombre"):Update(dt),
+// ParticleSystem.getInstance():Emit(emisor, n)...
+void RegisterEngineBindings(lua_State* L)
 {
-    float x = (float)lua_tonumber(L, 1);
-    float y = (float)lua_tonumber(L, 2);
-    float width = (float)lua_tonumber(L, 3);
-    float height = (float)lua_tonumber(L, 4);
-    int r = (float)lua_tonumber(L, 5);
-    int g = (float)lua_tonumber(L, 6);
-    int b = (float)lua_tonumber(L, 7);
-    int a = (float)lua_tonumber(L, 8);
-    Color c = { r, g, b, a };
-    DrawRectangle(x, y, width, height, c);
-    return 0;
-}
+    static const luaL_Reg audioMethods[] =
+    {
+    { "LoadBackgroundMusic", LuaBind<&AudioManager::LoadBackgroundMusic> },
+    { "Play", LuaBind<&AudioManager::playSound> },
+    { NULL, NULL }
+    };
+    static const luaL_Reg audioStatics[] =
+    {
+    { "getInstance", LuaBind<&AudioManager::getInstance> },
+    { NULL, NULL }
+    };
+    LuaClass<AudioManager>::Register(L, "AudioManager", audioMethods, audioStatics);
 
-int drawLine(lua_State* L)
-{
-    float x1 = (float)lua_tonumber(L, 1);
-    float y1 = (float)lua_tonumber(L, 2);
-    float x2 = (float)lua_tonumber(L, 3);
-    float y2 = (float)lua_tonumber(L, 4);
-    int r = (float)lua_tonumber(L, 5);
-    int g = (float)lua_tonumber(L, 6);
-    int b = (float)lua_tonumber(L, 7);
-    int a = (float)lua_tonumber(L, 8);
-    Color c = { r, g, b, a };
-    DrawLine(x1, y1, x2, y2, c);
-    return 0;
-}
+    static const luaL_Reg gameObjectMethods[] =
+    {
+    { "Update", LuaBind<&GameObject::Update> },
+    { "Draw", LuaBind<&GameObject::Draw> },
+    { "IsEnabled", LuaGetField<GameObject, bool, &GameObject::enabled> },
+    { "SetEnabled", LuaSetField<GameObject, bool, &GameObject::enabled> },
+    { NULL, NULL }
+    };
+    static const luaL_Reg gameObjectStatics[] =
+    {
+    { "Spawn", LuaBind<&GameObject::Spawn> },
+    { NULL, NULL }
+    };
+    LuaClass<GameObject>::Register(L, "GameObject", gameObjectMethods, gameObjectStatics);
 
-//para crear la biblioteca de funciones en lua
-int lua_mymodule(lua_State* L)
-{
-    static const luaL_Reg myModule[] =
+    static const luaL_Reg particleMethods[] =
     {
-    { "Clear", Clear },
-    { "DrawCircle", drawCircle },
-    { "DrawRect", drawRect },
-    { "DrawLine", drawLine },
+    { "CreateEmitter", LuaBind<&ParticleSystem::CreateEmitter> },
+    { "Emit", LuaBind<&ParticleSystem::Emit> },
+    { "SetEmitterPosition", LuaBind<&ParticleSystem::SetEmitterPosition> },
+    { "GetParticleCount", LuaBind<&ParticleSystem::GetParticleCount> },
     { NULL, NULL }
     };
-    luaL_newlib(L, myModule);
-    return 1;
+    static const luaL_Reg particleStatics[] =
+    {
+    { "getInstance", LuaBind<&ParticleSystem::getInstance> },
+    { NULL, NULL }
+    };
+    LuaClass<ParticleSystem>::Register(L, "ParticleSystem", particleMethods, particleStatics);
 }
 
 void DebugLog(LogLevel level, Module module, const char* message) {
@@ -184,6 +238,9 @@ typedef struct {
     int resY;
     bool fullscreen;
     bool vsync;
+    float drawDistance;     // 0 = sin culling por distancia
+    PacingConfig pacing;    // Resolucion dinamica del pase 3D
+    WorldStreamConfig world;    // Chunks del mundo alrededor de la camara
 } VideoConfig;
 
 void LoadConfig(const char* filename, VideoConfig* config) {
@@ -199,6 +256,16 @@ void LoadConfig(const char* filename, VideoConfig* config) {
         if (sscanf(line, "resy=%d", &config->resY) == 1) continue;
         if (sscanf(line, "fullscreen=%d", (int*)&config->fullscreen) == 1) continue;
         if (sscanf(line, "vsync=%d", (int*)&config->vsync) == 1) continue;
+        if (sscanf(line, "drawdistance=%f", &config->drawDistance) == 1) continue;
+        if (sscanf(line, "targetfps=%f", &config->pacing.targetFps) == 1) continue;
+        if (sscanf(line, "minscale=%f", &config->pacing.minScale) == 1) continue;
+        if (sscanf(line, "maxscale=%f", &config->pacing.maxScale) == 1) continue;
+        if (sscanf(line, "chunksize=%f", &config->world.chunkSize) == 1) continue;
+        if (sscanf(line, "streamradius=%d", &config->world.loadRadius) == 1) continue;
+        if (sscanf(line, "streammb=%d", &config->world.memoryBudgetMB) == 1) continue;
+
+        int dynres;
+        if (sscanf(line, "dynres=%d", &dynres) == 1) { config->pacing.enabled = dynres != 0; continue; }
     }
 
     fclose(file);
@@ -258,11 +325,83 @@ void DrawCubeTexture(Texture2D texture, Vector3 position, float width, float hei
     rlSetTexture(0);
 }
 
+// -----------------------------------------------------------------------------
+// Archivos soltados sobre la ventana: modelos y texturas del modelo
+// -----------------------------------------------------------------------------
+void HandleDroppedFiles(const InputFrame* input, SceneModel* sceneModel, Texture2D* texture, SceneIndex* scene)
+{
+    if (input->droppedFiles.size() != 1) return;
+
+    const char* droppedFile = input->droppedFiles[0].c_str();
+    if (IsFileExtension(droppedFile, ".obj") ||
+        IsFileExtension(droppedFile, ".gltf") ||
+        IsFileExtension(droppedFile, ".glb") ||
+        IsFileExtension(droppedFile, ".vox") ||
+        IsFileExtension(droppedFile, ".iqm") ||
+        IsFileExtension(droppedFile, ".m3d"))
+    {
+        UnloadSceneModel(sceneModel);
+        LoadSceneModel(sceneModel, droppedFile);
+        sceneModel->model.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = *texture;
+        scene->MarkDirty();
+    }
+    else if (IsFileExtension(droppedFile, ".png"))
+    {
+        UnloadTexture(*texture);
+        *texture = LoadTexture(droppedFile);
+        sceneModel->model.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = *texture;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Telemetria por frame, dibujada en la esquina superior izquierda
+// -----------------------------------------------------------------------------
+typedef struct {
+    SceneStats scene;
+    float simulationMs;
+    float renderMs;
+    float renderScale;
+    int particles;
+    WorldStreamStats world;
+} FrameTelemetry;
+
+void DrawTelemetry(const FrameTelemetry* telemetry)
+{
+    DrawFPS(10, 10);
+    DrawText(TextFormat("Instancias: %d/%d  Meshes visibles: %d  descartados: %d",
+        telemetry->scene.visibleInstances, telemetry->scene.instances,
+        telemetry->scene.visibleMeshes, telemetry->scene.culledMeshes), 10, 35, 20, LIME);
+    DrawText(TextFormat("Triangulos: %d  LOD0-3: %d/%d/%d/%d", telemetry->scene.triangles,
+        telemetry->scene.lodMeshes[0], telemetry->scene.lodMeshes[1],
+        telemetry->scene.lodMeshes[2], telemetry->scene.lodMeshes[3]), 10, 60, 20, LIME);
+    DrawText(TextFormat("Simulacion: %.2f ms  Render: %.2f ms", telemetry->simulationMs, telemetry->renderMs), 10, 85, 20, LIME);
+    DrawText(TextFormat("Escala 3D: %d%%", (int)(telemetry->renderScale * 100.0f + 0.5f)), 10, 110, 20, LIME);
+    DrawText(TextFormat("Particulas: %d", telemetry->particles), 10, 135, 20, LIME);
+    DrawText(TextFormat("Chunks: %d residentes, %d cargando  Memoria: %.1f/%.0f MB  Streaming: %.2f ms",
+        telemetry->world.residentChunks, telemetry->world.loadingChunks,
+        telemetry->world.residentBytes / (1024.0f * 1024.0f), telemetry->world.budgetBytes / (1024.0f * 1024.0f),
+        telemetry->world.updateMs), 10, 160, 20, LIME);
+}
+
 // -----------------------------------------------------------------------------
 // Funcin principal
 // -----------------------------------------------------------------------------
 int main(int argc, char** argv)
 {
+    if (argc > 1 && strcmp(argv[1], "--bunnymark") == 0) return RunBunnymark();
+    if (argc > 1 && strcmp(argv[1], "--luabench") == 0) return RunLuaBindingBenchmark();
+    if (argc > 1 && strcmp(argv[1], "--particlebench") == 0) return RunParticleBenchmark();
+
+    // --record <archivo> graba la entrada de la sesion; --replay <archivo> la
+    // reproduce frame a frame con el mismo dt, para pruebas de rendimiento
+    InputRecorder inputRecorder;
+    for (int i = 1; i + 1 < argc; i++)
+    {
+        if (strcmp(argv[i], "--record") == 0 && !inputRecorder.StartRecording(argv[i + 1]))
+            printf("No se puede crear la grabacion %s\n", argv[i + 1]);
+        if (strcmp(argv[i], "--replay") == 0 && !inputRecorder.StartReplay(argv[i + 1]))
+            printf("No se puede abrir la grabacion %s\n", argv[i + 1]);
+    }
 
     //prueba md5
     char* input = "Hello, World!";
@@ -282,6 +421,8 @@ int main(int argc, char** argv)
     // Inicializar lua y cargar funciones del de dibujo usando main.lua
     lua_State* L = luaL_newstate();
     luaL_openlibs(L);
+    LuaRegisterValueTypes(L);
+    RegisterEngineBindings(L);
     luaL_requiref(L, "SimpleDraw", lua_mymodule, 1);
     lua_pop(L, 1);
 
@@ -296,7 +437,7 @@ int main(int argc, char** argv)
 
 
 
-    VideoConfig config = { 1024, 800, true, false };  // Valores predeterminados
+    VideoConfig config = { 1024, 800, true, false, 0.0f, { true, 60.0f, 0.5f, 1.0f }, { 64.0f, 1, 1.5f, 256, 2.0f } };  // Valores predeterminados
     LoadConfig("config.ini", &config);
     printf("Loaded config: resX=%d, resY=%d, fullscreen=%d, vsync=%d\n", config.resX, config.resY, config.fullscreen, config.vsync);
 
@@ -329,19 +470,25 @@ int main(int argc, char** argv)
 
 
 
-    Model model = LoadModel("resources/cottage_obj.obj");      // Carga el modelo
+    SceneModel cottage;
+    bool cottageLoaded = LoadSceneModel(&cottage, "resources/cottage_obj.obj");      // Carga el modelo y cachea sus bounds
     Texture2D texture = LoadTexture("resources/cottage_diffuse.png"); // Carga la textura
-    model.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = texture;
+    cottage.model.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = texture;
     Vector3 position = { 0.0f, 0.0f, 0.0f };
 
     // Verificar que el modelo se haya cargado correctamente
-    if (model.meshCount > 0) {
-        BoundingBox bounds = GetMeshBoundingBox(model.meshes[0]);
-    }
-    else {
+    if (!cottageLoaded) {
         DebugLog(LOG_LEVEL_ERROR, MODULE_FILES, "Error: No se pudieron cargar los meshes del modelo");
     }
 
+    SceneIndex scene;
+    scene.SetMaxDrawDistance(config.drawDistance);
+    scene.AddInstance(&cottage, position, 1.0f);
+    FrameTelemetry telemetry = { 0 };
+
+    FramePacer pacer;
+    pacer.Init(config.pacing);
+
 
     SearchAndSetResourceDir("resources");
 
@@ -355,9 +502,12 @@ int main(int argc, char** argv)
 #endif
     }
 
-    Image watermarkImage = LoadImage("watermark.png");    // Carga la imagen descargada
-    Texture2D watermarkTexture = LoadTextureFromImage(watermarkImage);
-    UnloadImage(watermarkImage);
+    // Las imagenes 2D pequenas van al atlas y se dibujan con el SpriteBatch
+    SpriteAtlas atlas;
+    SpriteBatch spriteBatch;
+    ParticleRenderer particleRenderer;
+    int watermarkSprite = atlas.AddImage("watermark.png");    // Carga la imagen descargada
+    if (!atlas.Build()) DebugLog(LOG_LEVEL_ERROR, MODULE_RENDER, "No se pudo crear el atlas de sprites");
 
    
 
@@ -397,6 +547,11 @@ int main(int argc, char** argv)
     camera.fovy = 45;
     camera.projection = CAMERA_PERSPECTIVE;
 
+    // El resto del mundo se carga por chunks alrededor de la camara (rutas
+    // relativas a resources)
+    WorldStreamer world;
+    world.Init("world", config.world, &scene);
+
     AudioManager::getInstance()->LoadBackgroundMusic("52_Big_Blue.mp3");
     AudioManager::getInstance()->playSound();
 
@@ -421,13 +576,14 @@ int main(int argc, char** argv)
         gameObjects.push_back(go);
     }*/
 
-    // Bucle principal
-    while (!WindowShouldClose())
+    // Simulacion de un frame (hilo de simulacion). Solo toca la camara, el
+    // cubo, la escena y Lua; el resultado queda en el paquete para el render
+    auto simulate = [&](const SimulationInput& in, FramePacket& packet)
     {
-        UpdateCamera(&camera, CAMERA_FREE);
-        AudioManager::getInstance()->Update();
+        double simStart = GetTime();
+        const InputFrame* simInput = &in.input;
 
-        
+        UpdateCameraFromInput(&camera, simInput);
 
         /* for (int i = 0; i < gameObjects.size(); i++) {
              if (gameObjects[i]->enabled)
@@ -439,47 +595,73 @@ int main(int argc, char** argv)
 
          }*/
 
+        packet.dt = simInput->dt;
+        packet.camera = camera;
+        scene.Cull(camera, (float)in.screenWidth / (float)in.screenHeight, packet.drawItems);
+        packet.sceneStats = scene.GetStats();
 
-        if (IsFileDropped())
-        {
-            FilePathList droppedFiles = LoadDroppedFiles();
-            if (droppedFiles.count == 1)
-            {
-                if (IsFileExtension(droppedFiles.paths[0], ".obj") ||
-                    IsFileExtension(droppedFiles.paths[0], ".gltf") ||
-                    IsFileExtension(droppedFiles.paths[0], ".glb") ||
-                    IsFileExtension(droppedFiles.paths[0], ".vox") ||
-                    IsFileExtension(droppedFiles.paths[0], ".iqm") ||
-                    IsFileExtension(droppedFiles.paths[0], ".m3d"))
-                {
-                    UnloadModel(model);
-                    model = LoadModel(droppedFiles.paths[0]);
-                    model.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = texture;
-                }
-                else if (IsFileExtension(droppedFiles.paths[0], ".png"))
-                {
-                    UnloadTexture(texture);
-                    texture = LoadTexture(droppedFiles.paths[0]);
-                    model.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = texture;
-                }
-            }
-            UnloadDroppedFiles(droppedFiles);
-        }
+        // El cubo se dibuja en la posicion de antes de aplicar la entrada, como antes
+        packet.cubePosition = Vector3{ cubeX, cubeY, cubeZ };
+        if (cubeY != 0.0f) cubeY -= gravity;
+        if (IsInputDown(simInput, INPUT_KEY_W)) cubeX += 0.5f;
+        if (IsInputDown(simInput, INPUT_KEY_S)) cubeX -= 0.5f;
+        if (IsInputDown(simInput, INPUT_KEY_A)) cubeZ -= 0.5f;
+        if (IsInputDown(simInput, INPUT_KEY_D)) cubeZ += 0.5f;
+        if ((cubeY != 10) && IsInputPressed(simInput, INPUT_KEY_SPACE)) cubeY += 15;
+
+        packet.luaCommands.clear();
+        SetLuaDrawTarget(&packet.luaCommands);
+        luaDraw(L, simInput->dt);
+        SetLuaDrawTarget(NULL);
+
+        // Las particulas emitidas por Lua este frame ya se integran en este
+        ParticleSystem::getInstance()->Update(simInput->dt);
+        ParticleSystem::getInstance()->Snapshot(packet.particles);
+
+        packet.simulationTime = GetTime() - simStart;
+    };
+
+    FramePipeline pipeline;
+    pipeline.Start(simulate);
+
+    // Primer frame: no hay nada en vuelo, asi que los archivos soltados se
+    // pueden aplicar directamente
+    InputFrame frameInput;
+    inputRecorder.Poll(&frameInput);
+    HandleDroppedFiles(&frameInput, &cottage, &texture, &scene);
+    pipeline.Submit(SimulationInput{ frameInput, GetScreenWidth(), GetScreenHeight() });
+
+    // Bucle principal: se dibuja el paquete N mientras se simula el N+1
+    double loopStart = GetTime();
+    while (!WindowShouldClose())
+    {
+        FramePacket* packet = pipeline.Wait();
+
+        // Con la simulacion parada se pueden tocar los recursos que lee
+        AudioManager::getInstance()->Update();
+        LodBuilder::getInstance()->Update();
+        world.Update(packet->camera.position, packet->dt);
+
+        inputRecorder.Poll(&frameInput);
+        if (inputRecorder.IsFinished()) break;
+
+        // Cargar un modelo invalida los meshes del paquete actual: en ese caso
+        // se dibuja primero y se aplica despues, sin solapar ese frame
+        bool hasDrops = !frameInput.droppedFiles.empty();
+        if (!hasDrops) pipeline.Submit(SimulationInput{ frameInput, GetScreenWidth(), GetScreenHeight() });
 
+        double renderStart = GetTime();
         BeginDrawing();
         ClearBackground(BLACK);
 
-        BeginMode3D(camera);
-        DrawModel(model, position, 1.0f, WHITE);
-        DrawCubeTexture(cubetext, Vector3{ cubeX, cubeY, cubeZ }, 5, 5, 5, RAYWHITE);
-        if (cubeY != 0.0f) cubeY -= gravity;
+        // El pase 3D va a la textura escalada; lo demas a resolucion nativa
+        pacer.Begin3D();
+        BeginMode3D(packet->camera);
+        DrawSceneItems(packet->drawItems);
+        DrawCubeTexture(cubetext, packet->cubePosition, 5, 5, 5, RAYWHITE);
         DrawGrid(20, 10);
-        if (IsKeyDown(KEY_W)) cubeX += 0.5f;
-        if (IsKeyDown(KEY_S)) cubeX -= 0.5f;
-        if (IsKeyDown(KEY_A)) cubeZ -= 0.5f;
-        if (IsKeyDown(KEY_D)) cubeZ += 0.5f;
-        if ((cubeY != 10) && IsKeyPressed(KEY_SPACE)) cubeY += 15;
         EndMode3D();
+        pacer.End3D();
 
         /*for (int i = 0; i < gameObjects.size(); i++)
         {
@@ -487,29 +669,66 @@ int main(int argc, char** argv)
         }*/
 
         // Dibujar la marca de agua en la esquina inferior derecha
-        if (watermarkTexture.id != 0)
+        spriteBatch.Begin(&atlas);
+        if (watermarkSprite >= 0)
         {
+            const Sprite& watermark = atlas.GetSprite(watermarkSprite);
             float scale = 0.5f;  // Escala: 0.5 equivale al 50% del tamao original
             int margin = 10;
             int screenWidth = GetScreenWidth();
             int screenHeight = GetScreenHeight();
             Vector2 watermarkPos = {
-                    screenWidth - (watermarkTexture.width * scale) - margin,
-                    screenHeight - (watermarkTexture.height * scale) - margin
+                    screenWidth - (watermark.source.width * scale) - margin,
+                    screenHeight - (watermark.source.height * scale) - margin
             };
-            DrawTextureEx(watermarkTexture, watermarkPos, 0.0f, scale, WHITE);
+            spriteBatch.Draw(watermarkSprite, watermarkPos, scale, WHITE);
         }
+        spriteBatch.End();
+
+        DrawLuaCommands(packet->luaCommands);
+        particleRenderer.Draw(packet->particles);
 
-        luaDraw(L, GetFrameTime());
+        telemetry.scene = packet->sceneStats;
+        telemetry.simulationMs = (float)(packet->simulationTime * 1000.0);
+        telemetry.renderScale = pacer.GetScale();
+        telemetry.world = world.GetStats();
+        telemetry.particles = 0;
+        for (size_t i = 0; i < packet->particles.size(); i++) telemetry.particles += (int)packet->particles[i].x.size();
+        DrawTelemetry(&telemetry);
 
         EndDrawing();
+        telemetry.renderMs = (float)((GetTime() - renderStart) * 1000.0);
+        world.ReleaseRetired();     // El paquete ya no apunta a sus meshes
+        pacer.Update(telemetry.renderMs / 1000.0f);     // Sin la espera a la simulacion
+
+        if (hasDrops)
+        {
+            HandleDroppedFiles(&frameInput, &cottage, &texture, &scene);
+            pipeline.Submit(SimulationInput{ frameInput, GetScreenWidth(), GetScreenHeight() });
+        }
+    }
+    pipeline.Stop();
+
+    if (inputRecorder.IsReplaying())
+    {
+        double elapsed = GetTime() - loopStart;
+        int frames = inputRecorder.GetFrameCount();
+        DebugLog(LOG_LEVEL_INFO, MODULE_INPUT, TextFormat("Replay: %d frames en %.2f s, %.3f ms/frame",
+            frames, elapsed, frames > 0 ? elapsed * 1000.0 / frames : 0.0));
     }
+    inputRecorder.Stop();
 
     // Liberar recursos
     UnloadTexture(texture);
     UnloadTexture(cubetext);
-    UnloadModel(model);
-    if (watermarkTexture.id != 0) UnloadTexture(watermarkTexture);
+    world.Shutdown();
+    UnloadSceneModel(&cottage);
+    LodBuilder::getInstance()->Shutdown();
+    atlas.Unload();
+    spriteBatch.Unload();
+    particleRenderer.Unload();
+    pacer.Unload();
+    ParticleSystem::getInstance()->Clear();
 
     //evita el Run-Time Check Failure #2 - Stack around the variable 'config' was corrupted.
 	fclose(configFile);
@@ -0,0 +1,638 @@
+#include "mesh_lod.h"
+#include <algorithm>
+#include <math.h>
+#include <string.h>
+#include <unordered_map>
+
+// Fraccion de triangulos de cada nivel respecto al original
+static const float LOD_RATIOS[MAX_LOD_LEVELS] = { 1.0f, 0.5f, 0.25f, 0.1f };
+
+// Tamano proyectado por debajo del cual se pasa al nivel siguiente
+static const float LOD_THRESHOLDS[MAX_LOD_LEVELS - 1] = { 0.5f, 0.25f, 0.1f };
+static const float LOD_HYSTERESIS = 0.15f;
+
+#define LOD_MIN_TRIANGLES 64
+
+// -----------------------------------------------------------------------------
+// Simplificacion por cuadricas (Garland-Heckbert), en la variante con umbral
+// creciente por iteracion: en vez de una cola de prioridad se colapsan todas
+// las aristas cuyo error queda bajo el umbral de la pasada
+// -----------------------------------------------------------------------------
+namespace {
+
+struct Vec3d {
+    double x, y, z;
+};
+
+static Vec3d Sub(Vec3d a, Vec3d b) { return Vec3d{ a.x - b.x, a.y - b.y, a.z - b.z }; }
+static Vec3d Cross(Vec3d a, Vec3d b) { return Vec3d{ a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x }; }
+static double Dot(Vec3d a, Vec3d b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+static Vec3d Normalize(Vec3d v)
+{
+    double len = sqrt(Dot(v, v));
+    if (len > 0) { v.x /= len; v.y /= len; v.z /= len; }
+    return v;
+}
+
+// Matriz simetrica 4x4 guardada como 10 coeficientes
+struct Quadric {
+    double m[10];
+
+    Quadric() { memset(m, 0, sizeof(m)); }
+    Quadric(double a, double b, double c, double d)
+    {
+        m[0] = a * a; m[1] = a * b; m[2] = a * c; m[3] = a * d;
+        m[4] = b * b; m[5] = b * c; m[6] = b * d;
+        m[7] = c * c; m[8] = c * d;
+        m[9] = d * d;
+    }
+
+    double Det(int a11, int a12, int a13, int a21, int a22, int a23, int a31, int a32, int a33) const
+    {
+        return m[a11] * m[a22] * m[a33] + m[a13] * m[a21] * m[a32] + m[a12] * m[a23] * m[a31]
+            - m[a13] * m[a22] * m[a31] - m[a11] * m[a23] * m[a32] - m[a12] * m[a21] * m[a33];
+    }
+
+    double Error(Vec3d p) const
+    {
+        return m[0] * p.x * p.x + 2 * m[1] * p.x * p.y + 2 * m[2] * p.x * p.z + 2 * m[3] * p.x
+            + m[4] * p.y * p.y + 2 * m[5] * p.y * p.z + 2 * m[6] * p.y
+            + m[7] * p.z * p.z + 2 * m[8] * p.z + m[9];
+    }
+
+    Quadric operator+(const Quadric& o) const
+    {
+        Quadric r;
+        for (int i = 0; i < 10; i++) r.m[i] = m[i] + o.m[i];
+        return r;
+    }
+};
+
+struct SimplifyVertex {
+    Vec3d p;
+    Quadric q;
+    int tstart;
+    int tcount;
+    bool border;
+};
+
+struct SimplifyTriangle {
+    int v[3];
+    double err[4];
+    Vec3d n;
+    bool deleted;
+    bool dirty;
+};
+
+struct SimplifyRef {
+    int tid;
+    int tvertex;
+};
+
+class Simplifier {
+public:
+    std::vector<SimplifyVertex> vertices;
+    std::vector<SimplifyTriangle> triangles;
+
+    void Run(int targetCount, double aggressiveness)
+    {
+        int deletedTriangles = 0;
+        int triangleCount = (int)triangles.size();
+        std::vector<int> deleted0, deleted1;
+
+        for (int iteration = 0; iteration < 100; iteration++)
+        {
+            if (triangleCount - deletedTriangles <= targetCount) break;
+            if (iteration % 5 == 0) UpdateMesh(iteration);
+
+            for (size_t i = 0; i < triangles.size(); i++) triangles[i].dirty = false;
+
+            double threshold = 0.000000001 * pow((double)(iteration + 3), aggressiveness);
+
+            for (size_t i = 0; i < triangles.size(); i++)
+            {
+                SimplifyTriangle& t = triangles[i];
+                if (t.err[3] > threshold || t.deleted || t.dirty) continue;
+
+                for (int j = 0; j < 3; j++)
+                {
+                    if (t.err[j] >= threshold) continue;
+
+                    int i0 = t.v[j];
+                    int i1 = t.v[(j + 1) % 3];
+                    SimplifyVertex& v0 = vertices[i0];
+                    SimplifyVertex& v1 = vertices[i1];
+
+                    // Los bordes (incluidas las costuras de UV) solo colapsan entre si
+                    if (v0.border != v1.border) continue;
+
+                    Vec3d p;
+                    CalculateError(i0, i1, &p);
+
+                    deleted0.resize(v0.tcount);
+                    deleted1.resize(v1.tcount);
+                    if (Flipped(p, i1, v0, deleted0)) continue;
+                    if (Flipped(p, i0, v1, deleted1)) continue;
+
+                    v0.p = p;
+                    v0.q = v1.q + v0.q;
+
+                    int tstart = (int)refs.size();
+                    UpdateTriangles(i0, v0, deleted0, &deletedTriangles);
+                    UpdateTriangles(i0, v1, deleted1, &deletedTriangles);
+
+                    int tcount = (int)refs.size() - tstart;
+                    if (tcount <= v0.tcount)
+                    {
+                        if (tcount) memmove(&refs[v0.tstart], &refs[tstart], tcount * sizeof(SimplifyRef));
+                    }
+                    else v0.tstart = tstart;
+
+                    v0.tcount = tcount;
+                    break;
+                }
+
+                if (triangleCount - deletedTriangles <= targetCount) break;
+            }
+        }
+
+        CompactMesh();
+    }
+
+    std::vector<int> remap;     // Indice de vertice original -> indice compactado (-1 si se elimino)
+
+private:
+    std::vector<SimplifyRef> refs;
+
+    double CalculateError(int id0, int id1, Vec3d* result)
+    {
+        Quadric q = vertices[id0].q + vertices[id1].q;
+        bool border = vertices[id0].border && vertices[id1].border;
+        double det = q.Det(0, 1, 2, 1, 4, 5, 2, 5, 7);
+
+        if (det != 0 && !border)
+        {
+            result->x = -1 / det * q.Det(1, 2, 3, 4, 5, 6, 5, 7, 8);
+            result->y = 1 / det * q.Det(0, 2, 3, 1, 5, 6, 2, 7, 8);
+            result->z = -1 / det * q.Det(0, 1, 3, 1, 4, 6, 2, 5, 8);
+            return q.Error(*result);
+        }
+
+        // Matriz singular o arista de borde: se prueba con los extremos y el punto medio
+        Vec3d p1 = vertices[id0].p;
+        Vec3d p2 = vertices[id1].p;
+        Vec3d p3 = { (p1.x + p2.x) / 2, (p1.y + p2.y) / 2, (p1.z + p2.z) / 2 };
+        double e1 = q.Error(p1);
+        double e2 = q.Error(p2);
+        double e3 = q.Error(p3);
+        double error = std::min(e1, std::min(e2, e3));
+        if (error == e1) *result = p1;
+        else if (error == e2) *result = p2;
+        else *result = p3;
+        return error;
+    }
+
+    // Comprueba si mover el vertice a p invierte alguno de sus triangulos
+    bool Flipped(Vec3d p, int other, const SimplifyVertex& v, std::vector<int>& deleted)
+    {
+        for (int k = 0; k < v.tcount; k++)
+        {
+            const SimplifyRef& r = refs[v.tstart + k];
+            const SimplifyTriangle& t = triangles[r.tid];
+            if (t.deleted) continue;
+
+            int id1 = t.v[(r.tvertex + 1) % 3];
+            int id2 = t.v[(r.tvertex + 2) % 3];
+            if (id1 == other || id2 == other)
+            {
+                deleted[k] = 1;
+                continue;
+            }
+
+            Vec3d d1 = Normalize(Sub(vertices[id1].p, p));
+            Vec3d d2 = Normalize(Sub(vertices[id2].p, p));
+            if (fabs(Dot(d1, d2)) > 0.999) return true;
+
+            Vec3d n = Normalize(Cross(d1, d2));
+            deleted[k] = 0;
+            if (Dot(n, t.n) < 0.2) return true;
+        }
+        return false;
+    }
+
+    void UpdateTriangles(int i0, const SimplifyVertex& v, const std::vector<int>& deleted, int* deletedTriangles)
+    {
+        Vec3d p;
+        for (int k = 0; k < v.tcount; k++)
+        {
+            SimplifyRef r = refs[v.tstart + k];
+            SimplifyTriangle& t = triangles[r.tid];
+            if (t.deleted) continue;
+
+            if (deleted[k])
+            {
+                t.deleted = true;
+                (*deletedTriangles)++;
+                continue;
+            }
+
+            t.v[r.tvertex] = i0;
+            t.dirty = true;
+            t.err[0] = CalculateError(t.v[0], t.v[1], &p);
+            t.err[1] = CalculateError(t.v[1], t.v[2], &p);
+            t.err[2] = CalculateError(t.v[2], t.v[0], &p);
+            t.err[3] = std::min(t.err[0], std::min(t.err[1], t.err[2]));
+            refs.push_back(r);
+        }
+    }
+
+    void UpdateMesh(int iteration)
+    {
+        if (iteration > 0)
+        {
+            size_t dst = 0;
+            for (size_t i = 0; i < triangles.size(); i++)
+                if (!triangles[i].deleted) triangles[dst++] = triangles[i];
+            triangles.resize(dst);
+        }
+
+        // Referencias vertice -> triangulos
+        for (size_t i = 0; i < vertices.size(); i++)
+        {
+            vertices[i].tstart = 0;
+            vertices[i].tcount = 0;
+        }
+        for (size_t i = 0; i < triangles.size(); i++)
+            for (int j = 0; j < 3; j++) vertices[triangles[i].v[j]].tcount++;
+
+        int tstart = 0;
+        for (size_t i = 0; i < vertices.size(); i++)
+        {
+            vertices[i].tstart = tstart;
+            tstart += vertices[i].tcount;
+            vertices[i].tcount = 0;
+        }
+
+        refs.resize(triangles.size() * 3);
+        for (size_t i = 0; i < triangles.size(); i++)
+        {
+            for (int j = 0; j < 3; j++)
+            {
+                SimplifyVertex& v = vertices[triangles[i].v[j]];
+                refs[v.tstart + v.tcount] = SimplifyRef{ (int)i, j };
+                v.tcount++;
+            }
+        }
+
+        if (iteration != 0) return;
+
+        // Bordes: aristas que solo pertenecen a un triangulo
+        std::vector<int> vcount, vids;
+        for (size_t i = 0; i < vertices.size(); i++) vertices[i].border = false;
+
+        for (size_t i = 0; i < vertices.size(); i++)
+        {
+            const SimplifyVertex& v = vertices[i];
+            vcount.clear();
+            vids.clear();
+            for (int j = 0; j < v.tcount; j++)
+            {
+                const SimplifyTriangle& t = triangles[refs[v.tstart + j].tid];
+                for (int k = 0; k < 3; k++)
+                {
+                    size_t ofs = 0;
+                    while (ofs < vcount.size() && vids[ofs] != t.v[k]) ofs++;
+                    if (ofs == vcount.size())
+                    {
+                        vcount.push_back(1);
+                        vids.push_back(t.v[k]);
+                    }
+                    else vcount[ofs]++;
+                }
+            }
+            for (size_t j = 0; j < vcount.size(); j++)
+                if (vcount[j] == 1) vertices[vids[j]].border = true;
+        }
+
+        // Cuadricas iniciales a partir de los planos de cada triangulo
+        for (size_t i = 0; i < vertices.size(); i++) vertices[i].q = Quadric();
+
+        for (size_t i = 0; i < triangles.size(); i++)
+        {
+            SimplifyTriangle& t = triangles[i];
+            Vec3d p0 = vertices[t.v[0]].p;
+            Vec3d n = Normalize(Cross(Sub(vertices[t.v[1]].p, p0), Sub(vertices[t.v[2]].p, p0)));
+            t.n = n;
+            for (int j = 0; j < 3; j++)
+                vertices[t.v[j]].q = vertices[t.v[j]].q + Quadric(n.x, n.y, n.z, -Dot(n, p0));
+        }
+
+        Vec3d p;
+        for (size_t i = 0; i < triangles.size(); i++)
+        {
+            SimplifyTriangle& t = triangles[i];
+            for (int j = 0; j < 3; j++) t.err[j] = CalculateError(t.v[j], t.v[(j + 1) % 3], &p);
+            t.err[3] = std::min(t.err[0], std::min(t.err[1], t.err[2]));
+        }
+    }
+
+    void CompactMesh()
+    {
+        size_t dst = 0;
+        remap.assign(vertices.size(), -1);
+
+        for (size_t i = 0; i < triangles.size(); i++)
+        {
+            if (triangles[i].deleted) continue;
+            triangles[dst++] = triangles[i];
+            for (int j = 0; j < 3; j++) remap[triangles[i].v[j]] = 1;
+        }
+        triangles.resize(dst);
+
+        int next = 0;
+        for (size_t i = 0; i < vertices.size(); i++)
+            if (remap[i] == 1) remap[i] = next++;
+    }
+};
+
+// Clave para soldar vertices: posicion y coordenada de textura exactas
+struct WeldKey {
+    float v[5];
+    bool operator==(const WeldKey& o) const { return memcmp(v, o.v, sizeof(v)) == 0; }
+};
+
+struct WeldKeyHash {
+    size_t operator()(const WeldKey& k) const
+    {
+        size_t h = 2166136261u;
+        const unsigned char* bytes = (const unsigned char*)k.v;
+        for (size_t i = 0; i < sizeof(k.v); i++) h = (h ^ bytes[i]) * 16777619u;
+        return h;
+    }
+};
+
+}
+
+bool SimplifyMesh(const Mesh& source, int targetTriangles, Mesh* result)
+{
+    *result = Mesh{ 0 };
+    if (source.vertices == NULL || source.triangleCount <= 0) return false;
+    if (source.boneIds != NULL) return false;   // Los meshes con esqueleto no se simplifican
+
+    int cornerCount = source.triangleCount * 3;
+    auto corner = [&source](int i) { return source.indices ? (int)source.indices[i] : i; };
+
+    // Los loaders de OBJ generan vertices sin indexar: se sueldan por posicion+UV
+    // para recuperar la topologia. Las costuras de UV quedan como bordes
+    Simplifier simplifier;
+    std::vector<int> cornerToVertex(cornerCount);
+    std::vector<float> texcoords;
+    std::vector<float> normals;
+    std::unordered_map<WeldKey, int, WeldKeyHash> weld;
+    weld.reserve(cornerCount);
+
+    for (int i = 0; i < cornerCount; i++)
+    {
+        int src = corner(i);
+        WeldKey key = { { source.vertices[src * 3], source.vertices[src * 3 + 1], source.vertices[src * 3 + 2],
+            source.texcoords ? source.texcoords[src * 2] : 0.0f, source.texcoords ? source.texcoords[src * 2 + 1] : 0.0f } };
+
+        auto it = weld.find(key);
+        int id;
+        if (it == weld.end())
+        {
+            id = (int)simplifier.vertices.size();
+            weld.emplace(key, id);
+
+            SimplifyVertex v = {};
+            v.p = Vec3d{ key.v[0], key.v[1], key.v[2] };
+            simplifier.vertices.push_back(v);
+            texcoords.push_back(key.v[3]);
+            texcoords.push_back(key.v[4]);
+            normals.push_back(0.0f);
+            normals.push_back(0.0f);
+            normals.push_back(0.0f);
+        }
+        else id = it->second;
+
+        // Las normales de las esquinas soldadas se promedian
+        if (source.normals)
+        {
+            normals[id * 3] += source.normals[src * 3];
+            normals[id * 3 + 1] += source.normals[src * 3 + 1];
+            normals[id * 3 + 2] += source.normals[src * 3 + 2];
+        }
+        cornerToVertex[i] = id;
+    }
+
+    simplifier.triangles.resize(source.triangleCount);
+    for (int i = 0; i < source.triangleCount; i++)
+    {
+        SimplifyTriangle& t = simplifier.triangles[i];
+        t = SimplifyTriangle{};
+        for (int j = 0; j < 3; j++) t.v[j] = cornerToVertex[i * 3 + j];
+    }
+
+    simplifier.Run(targetTriangles, 7.0);
+
+    int triangleCount = (int)simplifier.triangles.size();
+    if (triangleCount == 0 || triangleCount >= source.triangleCount) return false;
+
+    int vertexCount = 0;
+    for (size_t i = 0; i < simplifier.remap.size(); i++)
+        if (simplifier.remap[i] >= 0) vertexCount++;
+
+    // Con mas de 65535 vertices no caben en indices de 16 bits: se expande
+    bool indexed = vertexCount <= 65535;
+    int outVertices = indexed ? vertexCount : triangleCount * 3;
+
+    result->vertexCount = outVertices;
+    result->triangleCount = triangleCount;
+    result->vertices = (float*)MemAlloc(outVertices * 3 * sizeof(float));
+    if (source.texcoords) result->texcoords = (float*)MemAlloc(outVertices * 2 * sizeof(float));
+    if (source.normals) result->normals = (float*)MemAlloc(outVertices * 3 * sizeof(float));
+    if (indexed) result->indices = (unsigned short*)MemAlloc(triangleCount * 3 * sizeof(unsigned short));
+
+    auto writeVertex = [&](int dst, int id) {
+        const SimplifyVertex& v = simplifier.vertices[id];
+        result->vertices[dst * 3] = (float)v.p.x;
+        result->vertices[dst * 3 + 1] = (float)v.p.y;
+        result->vertices[dst * 3 + 2] = (float)v.p.z;
+        if (result->texcoords)
+        {
+            result->texcoords[dst * 2] = texcoords[id * 2];
+            result->texcoords[dst * 2 + 1] = texcoords[id * 2 + 1];
+        }
+        if (result->normals)
+        {
+            float nx = normals[id * 3], ny = normals[id * 3 + 1], nz = normals[id * 3 + 2];
+            float len = sqrtf(nx * nx + ny * ny + nz * nz);
+            if (len > 0) { nx /= len; ny /= len; nz /= len; }
+            result->normals[dst * 3] = nx;
+            result->normals[dst * 3 + 1] = ny;
+            result->normals[dst * 3 + 2] = nz;
+        }
+    };
+
+    if (indexed)
+    {
+        for (size_t i = 0; i < simplifier.remap.size(); i++)
+            if (simplifier.remap[i] >= 0) writeVertex(simplifier.remap[i], (int)i);
+
+        for (int i = 0; i < triangleCount; i++)
+            for (int j = 0; j < 3; j++)
+                result->indices[i * 3 + j] = (unsigned short)simplifier.remap[simplifier.triangles[i].v[j]];
+    }
+    else
+    {
+        for (int i = 0; i < triangleCount; i++)
+            for (int j = 0; j < 3; j++) writeVertex(i * 3 + j, simplifier.triangles[i].v[j]);
+    }
+
+    return true;
+}
+
+void FreeMeshData(Mesh* mesh)
+{
+    MemFree(mesh->vertices);
+    MemFree(mesh->texcoords);
+    MemFree(mesh->normals);
+    MemFree(mesh->indices);
+    *mesh = Mesh{ 0 };
+}
+
+int SelectLodLevel(float screenSize, int currentLevel, int levelCount)
+{
+    int level = std::min(std::max(currentLevel, 0), levelCount - 1);
+    while (level < levelCount - 1 && screenSize < LOD_THRESHOLDS[level] * (1.0f - LOD_HYSTERESIS)) level++;
+    while (level > 0 && screenSize > LOD_THRESHOLDS[level - 1] * (1.0f + LOD_HYSTERESIS)) level--;
+    return level;
+}
+
+// -----------------------------------------------------------------------------
+// LodBuilder
+// -----------------------------------------------------------------------------
+LodBuilder* LodBuilder::getInstance()
+{
+    static LodBuilder instance;
+    return &instance;
+}
+
+void LodBuilder::Start()
+{
+    unsigned int count = std::thread::hardware_concurrency();
+    count = count > 2 ? count - 1 : 1;
+    stopping = false;
+    for (unsigned int i = 0; i < count; i++) workers.emplace_back(&LodBuilder::WorkerLoop, this);
+}
+
+void LodBuilder::Request(const void* owner, MeshLods* target)
+{
+    if (target->levels[0].triangleCount < LOD_MIN_TRIANGLES) return;
+    if (workers.empty()) Start();
+
+    LodJob* job = new LodJob();
+    job->owner = owner;
+    job->target = target;
+    job->source = target->levels[0];
+    job->resultCount = 0;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    pending.push_back(job);
+    jobReady.notify_one();
+}
+
+void LodBuilder::WorkerLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+        jobReady.wait(lock, [this] { return stopping || !pending.empty(); });
+        if (stopping) return;
+
+        LodJob* job = pending.front();
+        pending.pop_front();
+        running.push_back(job);
+        lock.unlock();
+
+        // Cada nivel se simplifica a partir del anterior, que ya es mas pequeno
+        const Mesh* from = &job->source;
+        for (int level = 1; level < MAX_LOD_LEVELS; level++)
+        {
+            int target = (int)(job->source.triangleCount * LOD_RATIOS[level]);
+            if (!SimplifyMesh(*from, target, &job->results[job->resultCount])) break;
+            from = &job->results[job->resultCount];
+            job->resultCount++;
+        }
+
+        lock.lock();
+        running.erase(std::find(running.begin(), running.end(), job));
+        done.push_back(job);
+        jobFinished.notify_all();
+    }
+}
+
+void LodBuilder::Cancel(const void* owner)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    pending.erase(std::remove_if(pending.begin(), pending.end(), [owner](LodJob* job) {
+        if (job->owner != owner) return false;
+        delete job;
+        return true;
+    }), pending.end());
+
+    jobFinished.wait(lock, [this, owner] {
+        return std::none_of(running.begin(), running.end(), [owner](LodJob* job) { return job->owner == owner; });
+    });
+
+    done.erase(std::remove_if(done.begin(), done.end(), [owner](LodJob* job) {
+        if (job->owner != owner) return false;
+        for (int i = 0; i < job->resultCount; i++) FreeMeshData(&job->results[i]);
+        delete job;
+        return true;
+    }), done.end());
+}
+
+void LodBuilder::Update(int maxUploads)
+{
+    // Limite de subidas por frame para no meter tirones al cargar modelos grandes
+    for (int uploads = 0; uploads < maxUploads; uploads++)
+    {
+        LodJob* job;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (done.empty()) return;
+            job = done.front();
+            done.pop_front();
+        }
+
+        MeshLods* target = job->target;
+        for (int i = 0; i < job->resultCount; i++)
+        {
+            UploadMesh(&job->results[i], false);
+            target->levels[target->levelCount++] = job->results[i];
+        }
+        delete job;
+    }
+}
+
+void LodBuilder::Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        jobReady.notify_all();
+    }
+    for (size_t i = 0; i < workers.size(); i++) workers[i].join();
+    workers.clear();
+
+    for (size_t i = 0; i < pending.size(); i++) delete pending[i];
+    for (size_t i = 0; i < done.size(); i++)
+    {
+        for (int j = 0; j < done[i]->resultCount; j++) FreeMeshData(&done[i]->results[j]);
+        delete done[i];
+    }
+    pending.clear();
+    done.clear();
+}
@@ -0,0 +1,101 @@
+#include "particle_bench.h"
+#include "particle_system.h"
+#include <chrono>
+#include <stdio.h>
+
+#define PARTICLE_BENCH_COUNT 1000000
+#define PARTICLE_BENCH_FRAMES 200
+#define PARTICLE_BENCH_DT (1.0f / 60.0f)
+
+typedef int (*ParticleKernel)(ParticleBuffers*, float, Vector2, float);
+
+static double Now(void)
+{
+    return std::chrono::duration<double>(std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+}
+
+// Particulas de vida larga para que el numero no baje durante la medida
+static void FillBuffers(ParticleBuffers* b)
+{
+    unsigned int seed = 12345u;
+    for (int i = 0; i < b->capacity; i++)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        float r = (seed >> 8) * (1.0f / 16777216.0f);
+        b->px[i] = r * 1024.0f;
+        b->py[i] = (1.0f - r) * 800.0f;
+        b->vx[i] = (r - 0.5f) * 100.0f;
+        b->vy[i] = (0.5f - r) * 100.0f;
+        b->life[i] = 1000.0f + r;
+    }
+    b->count = b->capacity;
+}
+
+static double TimeKernel(ParticleKernel kernel)
+{
+    ParticleBuffers buffers;
+    if (!AllocParticleBuffers(&buffers, PARTICLE_BENCH_COUNT)) return 0.0;
+    FillBuffers(&buffers);
+
+    Vector2 gravity = { 0.0f, 200.0f };
+    kernel(&buffers, PARTICLE_BENCH_DT, gravity, 0.5f);     // Calienta caches
+
+    double start = Now();
+    for (int frame = 0; frame < PARTICLE_BENCH_FRAMES; frame++)
+        kernel(&buffers, PARTICLE_BENCH_DT, gravity, 0.5f);
+    double elapsed = Now() - start;
+
+    FreeParticleBuffers(&buffers);
+    return elapsed / PARTICLE_BENCH_FRAMES;
+}
+
+int RunParticleBenchmark(void)
+{
+    printf("[PARTICLEBENCH] %d particulas, %d frames, kernel SIMD: %s\n",
+        PARTICLE_BENCH_COUNT, PARTICLE_BENCH_FRAMES, GetParticleKernelName());
+
+    double scalar = TimeKernel(UpdateParticlesScalar);
+    double simd = TimeKernel(UpdateParticlesSimd);
+    printf("[PARTICLEBENCH] %-28s %8.3f ms/frame\n", "escalar", scalar * 1000.0);
+    printf("[PARTICLEBENCH] %-28s %8.3f ms/frame (x%.2f)\n", GetParticleKernelName(), simd * 1000.0,
+        simd > 0.0 ? scalar / simd : 0.0);
+
+    // Frame completo en regimen estable: lo que muere se repone cada frame
+    EmitterConfig config = DefaultEmitterConfig();
+    config.capacity = PARTICLE_BENCH_COUNT;
+    config.lifetime = 1.0f;
+    config.position = { 512.0f, 400.0f };
+
+    ParticleSystem* particles = ParticleSystem::getInstance();
+    int emitter = particles->CreateEmitter(config);
+    std::vector<ParticleDrawBatch> snapshot;
+    int perFrame = (int)(PARTICLE_BENCH_COUNT * PARTICLE_BENCH_DT / config.lifetime) + 1;
+
+    double updateTime = 0.0;
+    double snapshotTime = 0.0;
+    int frames = 0;
+    for (int frame = 0; frame < PARTICLE_BENCH_FRAMES; frame++)
+    {
+        double start = Now();
+        particles->Emit(emitter, perFrame);
+        particles->Update(PARTICLE_BENCH_DT);
+        double mid = Now();
+        particles->Snapshot(snapshot);
+        double end = Now();
+
+        // Solo cuentan los frames con el emisor ya lleno
+        if (frame < (int)(config.lifetime / PARTICLE_BENCH_DT)) continue;
+        updateTime += mid - start;
+        snapshotTime += end - mid;
+        frames++;
+    }
+    if (frames > 0)
+    {
+        printf("[PARTICLEBENCH] %-28s %8.3f ms/frame (%d vivas)\n", "emision + actualizacion",
+            updateTime * 1000.0 / frames, particles->GetParticleCount());
+        printf("[PARTICLEBENCH] %-28s %8.3f ms/frame\n", "copia para el render", snapshotTime * 1000.0 / frames);
+    }
+
+    particles->Clear();
+    return 0;
+}
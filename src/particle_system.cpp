@@ -0,0 +1,326 @@
+#include "particle_system.h"
+#include "rlgl.h"
+#include <algorithm>
+#include <stdlib.h>
+
+// El camino SIMD se elige al compilar: AVX si el compilador lo habilita
+// (/arch:AVX, -mavx), SSE2 en cualquier x64, escalar en el resto (ARM64)
+#if defined(__AVX__)
+#include <immintrin.h>
+#define PARTICLE_SIMD_WIDTH 8
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PARTICLE_SIMD_WIDTH 4
+#else
+#define PARTICLE_SIMD_WIDTH 1
+#endif
+
+#define PARTICLE_ALIGNMENT 32
+#define PARTICLE_ARRAYS 5
+
+EmitterConfig DefaultEmitterConfig(void)
+{
+    EmitterConfig config;
+    config.position = { 0.0f, 0.0f };
+    config.velocity = { 0.0f, -120.0f };
+    config.spread = { 40.0f, 40.0f };
+    config.gravity = { 0.0f, 200.0f };
+    config.drag = 0.5f;
+    config.lifetime = 2.0f;
+    config.size = 3.0f;
+    config.startColor = WHITE;
+    config.endColor = { 255, 255, 255, 0 };
+    config.capacity = 10000;
+    return config;
+}
+
+// -----------------------------------------------------------------------------
+// Almacenamiento SoA
+// -----------------------------------------------------------------------------
+bool AllocParticleBuffers(ParticleBuffers* buffers, int capacity)
+{
+    *buffers = ParticleBuffers{ 0 };
+    if (capacity <= 0) return false;
+
+    int padded = (capacity + 7) & ~7;
+    size_t bytes = (size_t)padded * PARTICLE_ARRAYS * sizeof(float);
+#if PARTICLE_SIMD_WIDTH > 1
+    float* block = (float*)_mm_malloc(bytes, PARTICLE_ALIGNMENT);
+#else
+    float* block = (float*)malloc(bytes);
+#endif
+    if (block == NULL) return false;
+
+    // El relleno tambien se inicializa: los kernels lo recorren
+    std::fill(block, block + (size_t)padded * PARTICLE_ARRAYS, 0.0f);
+    buffers->px = block;
+    buffers->py = block + padded;
+    buffers->vx = block + padded * 2;
+    buffers->vy = block + padded * 3;
+    buffers->life = block + padded * 4;
+    buffers->capacity = capacity;
+    return true;
+}
+
+void FreeParticleBuffers(ParticleBuffers* buffers)
+{
+#if PARTICLE_SIMD_WIDTH > 1
+    if (buffers->px != NULL) _mm_free(buffers->px);
+#else
+    free(buffers->px);
+#endif
+    *buffers = ParticleBuffers{ 0 };
+}
+
+// -----------------------------------------------------------------------------
+// Kernels
+// -----------------------------------------------------------------------------
+
+// Mueve la ultima particula viva al hueco de la muerta; el orden no importa
+static inline void RemoveParticle(ParticleBuffers* b, int i, int last)
+{
+    b->px[i] = b->px[last];
+    b->py[i] = b->py[last];
+    b->vx[i] = b->vx[last];
+    b->vy[i] = b->vy[last];
+    b->life[i] = b->life[last];
+}
+
+int UpdateParticlesScalar(ParticleBuffers* b, float dt, Vector2 gravity, float drag)
+{
+    float damping = std::max(0.0f, 1.0f - drag * dt);
+    float gx = gravity.x * dt;
+    float gy = gravity.y * dt;
+    int count = b->count;
+
+    for (int i = 0; i < count; i++)
+    {
+        b->vx[i] = (b->vx[i] + gx) * damping;
+        b->vy[i] = (b->vy[i] + gy) * damping;
+        b->px[i] += b->vx[i] * dt;
+        b->py[i] += b->vy[i] * dt;
+        b->life[i] -= dt;
+    }
+
+    int i = 0;
+    while (i < count)
+    {
+        if (b->life[i] > 0.0f) { i++; continue; }
+        RemoveParticle(b, i, --count);
+    }
+    b->count = count;
+    return count;
+}
+
+int UpdateParticlesSimd(ParticleBuffers* b, float dt, Vector2 gravity, float drag)
+{
+#if PARTICLE_SIMD_WIDTH == 1
+    return UpdateParticlesScalar(b, dt, gravity, drag);
+#else
+    float damping = std::max(0.0f, 1.0f - drag * dt);
+    int count = b->count;
+
+    // Los arrays estan alineados y rellenos hasta multiplo de 8, asi que el
+    // ultimo bloque puede pasarse de count sin cola escalar
+#if PARTICLE_SIMD_WIDTH == 8
+    __m256 vdt = _mm256_set1_ps(dt);
+    __m256 vgx = _mm256_set1_ps(gravity.x * dt);
+    __m256 vgy = _mm256_set1_ps(gravity.y * dt);
+    __m256 vdamp = _mm256_set1_ps(damping);
+    for (int i = 0; i < count; i += 8)
+    {
+        __m256 vx = _mm256_mul_ps(_mm256_add_ps(_mm256_load_ps(b->vx + i), vgx), vdamp);
+        __m256 vy = _mm256_mul_ps(_mm256_add_ps(_mm256_load_ps(b->vy + i), vgy), vdamp);
+        _mm256_store_ps(b->vx + i, vx);
+        _mm256_store_ps(b->vy + i, vy);
+        _mm256_store_ps(b->px + i, _mm256_add_ps(_mm256_load_ps(b->px + i), _mm256_mul_ps(vx, vdt)));
+        _mm256_store_ps(b->py + i, _mm256_add_ps(_mm256_load_ps(b->py + i), _mm256_mul_ps(vy, vdt)));
+        _mm256_store_ps(b->life + i, _mm256_sub_ps(_mm256_load_ps(b->life + i), vdt));
+    }
+#else
+    __m128 vdt = _mm_set1_ps(dt);
+    __m128 vgx = _mm_set1_ps(gravity.x * dt);
+    __m128 vgy = _mm_set1_ps(gravity.y * dt);
+    __m128 vdamp = _mm_set1_ps(damping);
+    for (int i = 0; i < count; i += 4)
+    {
+        __m128 vx = _mm_mul_ps(_mm_add_ps(_mm_load_ps(b->vx + i), vgx), vdamp);
+        __m128 vy = _mm_mul_ps(_mm_add_ps(_mm_load_ps(b->vy + i), vgy), vdamp);
+        _mm_store_ps(b->vx + i, vx);
+        _mm_store_ps(b->vy + i, vy);
+        _mm_store_ps(b->px + i, _mm_add_ps(_mm_load_ps(b->px + i), _mm_mul_ps(vx, vdt)));
+        _mm_store_ps(b->py + i, _mm_add_ps(_mm_load_ps(b->py + i), _mm_mul_ps(vy, vdt)));
+        _mm_store_ps(b->life + i, _mm_sub_ps(_mm_load_ps(b->life + i), vdt));
+    }
+#endif
+
+    // Descarte: los bloques sin ninguna muerta se saltan con una comparacion
+    // vectorial; solo se mira particula a particula donde hay alguna
+    int i = 0;
+    while (i < count)
+    {
+        if ((i & (PARTICLE_SIMD_WIDTH - 1)) == 0 && i + PARTICLE_SIMD_WIDTH <= count)
+        {
+#if PARTICLE_SIMD_WIDTH == 8
+            int dead = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_load_ps(b->life + i), _mm256_setzero_ps(), _CMP_LE_OQ));
+#else
+            int dead = _mm_movemask_ps(_mm_cmple_ps(_mm_load_ps(b->life + i), _mm_setzero_ps()));
+#endif
+            if (dead == 0) { i += PARTICLE_SIMD_WIDTH; continue; }
+        }
+        if (b->life[i] > 0.0f) { i++; continue; }
+        RemoveParticle(b, i, --count);
+    }
+    b->count = count;
+    return count;
+#endif
+}
+
+const char* GetParticleKernelName(void)
+{
+#if PARTICLE_SIMD_WIDTH == 8
+    return "AVX";
+#elif PARTICLE_SIMD_WIDTH == 4
+    return "SSE2";
+#else
+    return "escalar";
+#endif
+}
+
+// -----------------------------------------------------------------------------
+// Render
+// -----------------------------------------------------------------------------
+void ParticleRenderer::Draw(const std::vector<ParticleDrawBatch>& batches)
+{
+    if (buffers.size() < batches.size()) buffers.resize(batches.size());
+
+    for (size_t e = 0; e < batches.size(); e++)
+    {
+        const ParticleDrawBatch& batch = batches[e];
+        int count = (int)batch.x.size();
+        if (count == 0) continue;
+
+        float half = batch.size * 0.5f;
+        float invLifetime = batch.lifetime > 0.0f ? 1.0f / batch.lifetime : 0.0f;
+        Color c0 = batch.startColor;
+        Color c1 = batch.endColor;
+
+        QuadBuffer& buffer = buffers[e];
+        buffer.Clear();
+        QuadVertex* v = buffer.AddQuads(count);
+        for (int i = 0; i < count; i++, v += 6)
+        {
+            float t = 1.0f - batch.life[i] * invLifetime;
+            t = t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+            Color color = { (unsigned char)(c0.r + (c1.r - c0.r) * t), (unsigned char)(c0.g + (c1.g - c0.g) * t),
+                (unsigned char)(c0.b + (c1.b - c0.b) * t), (unsigned char)(c0.a + (c1.a - c0.a) * t) };
+            WriteQuad(v, batch.x[i] - half, batch.y[i] - half, batch.x[i] + half, batch.y[i] + half,
+                0.0f, 0.0f, 1.0f, 1.0f, color);
+        }
+        buffer.Draw(rlGetTextureIdDefault());
+    }
+}
+
+void ParticleRenderer::Unload()
+{
+    for (size_t i = 0; i < buffers.size(); i++) buffers[i].Unload();
+    buffers.clear();
+}
+
+// -----------------------------------------------------------------------------
+// ParticleSystem
+// -----------------------------------------------------------------------------
+ParticleSystem* ParticleSystem::getInstance()
+{
+    static ParticleSystem instance;
+    return &instance;
+}
+
+int ParticleSystem::CreateEmitter(EmitterConfig config)
+{
+    Emitter emitter;
+    emitter.config = config;
+    if (!AllocParticleBuffers(&emitter.buffers, config.capacity))
+    {
+        TraceLog(LOG_WARNING, "PARTICLES: No se pudo reservar un emisor de %d particulas", config.capacity);
+        return -1;
+    }
+    emitters.push_back(emitter);
+    return (int)emitters.size() - 1;
+}
+
+// xorshift32: mucho mas barato que GetRandomValue para miles de particulas
+float ParticleSystem::RandomRange(float spread)
+{
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    float unit = (randomState >> 8) * (1.0f / 16777216.0f);
+    return (unit * 2.0f - 1.0f) * spread;
+}
+
+void ParticleSystem::Emit(int emitter, int count)
+{
+    if (emitter < 0 || emitter >= (int)emitters.size()) return;
+    Emitter& e = emitters[emitter];
+    ParticleBuffers& b = e.buffers;
+
+    int end = std::min(b.capacity, b.count + std::max(0, count));
+    for (int i = b.count; i < end; i++)
+    {
+        b.px[i] = e.config.position.x;
+        b.py[i] = e.config.position.y;
+        b.vx[i] = e.config.velocity.x + RandomRange(e.config.spread.x);
+        b.vy[i] = e.config.velocity.y + RandomRange(e.config.spread.y);
+        b.life[i] = e.config.lifetime;
+    }
+    b.count = end;
+}
+
+void ParticleSystem::SetEmitterPosition(int emitter, Vector2 position)
+{
+    if (emitter < 0 || emitter >= (int)emitters.size()) return;
+    emitters[emitter].config.position = position;
+}
+
+int ParticleSystem::GetParticleCount() const
+{
+    int total = 0;
+    for (size_t i = 0; i < emitters.size(); i++) total += emitters[i].buffers.count;
+    return total;
+}
+
+void ParticleSystem::Update(float dt)
+{
+    for (size_t i = 0; i < emitters.size(); i++)
+    {
+        Emitter& e = emitters[i];
+        UpdateParticlesSimd(&e.buffers, dt, e.config.gravity, e.config.drag);
+    }
+}
+
+void ParticleSystem::Snapshot(std::vector<ParticleDrawBatch>& out) const
+{
+    // Los vectores del paquete se reutilizan entre frames: assign no reserva
+    // memoria una vez alcanzado el tamano maximo
+    out.resize(emitters.size());
+    for (size_t i = 0; i < emitters.size(); i++)
+    {
+        const Emitter& e = emitters[i];
+        const ParticleBuffers& b = e.buffers;
+        ParticleDrawBatch& batch = out[i];
+        batch.x.assign(b.px, b.px + b.count);
+        batch.y.assign(b.py, b.py + b.count);
+        batch.life.assign(b.life, b.life + b.count);
+        batch.size = e.config.size;
+        batch.lifetime = e.config.lifetime;
+        batch.startColor = e.config.startColor;
+        batch.endColor = e.config.endColor;
+    }
+}
+
+void ParticleSystem::Clear()
+{
+    for (size_t i = 0; i < emitters.size(); i++) FreeParticleBuffers(&emitters[i].buffers);
+    emitters.clear();
+}
@@ -0,0 +1,104 @@
+#include "quad_buffer.h"
+#include "rlgl.h"
+#include "raymath.h"
+
+#define QUAD_BUFFER_MIN_VERTICES (1024 * 6)
+
+void QuadBuffer::Allocate(int vertexCount)
+{
+    // Crece al doble para no recrear el buffer cada vez que sube la cuenta
+    int grown = vertexCount > capacity * 2 ? vertexCount : capacity * 2;
+    Unload();
+    capacity = grown;
+    if (capacity < QUAD_BUFFER_MIN_VERTICES) capacity = QUAD_BUFFER_MIN_VERTICES;
+
+    // Sin soporte de VAOs vao queda a 0 y los atributos se ponen en Draw();
+    // sin VBOs (OpenGL 1.1) tambien vbo queda a 0
+    vao = rlLoadVertexArray();
+    bool hasVao = rlEnableVertexArray(vao);
+    vbo = rlLoadVertexBuffer(NULL, capacity * (int)sizeof(QuadVertex), true);
+    if (hasVao)
+    {
+        SetAttributes();
+        rlDisableVertexArray();
+    }
+    rlDisableVertexBuffer();
+}
+
+// Atributos del shader por defecto sobre el buffer enlazado
+void QuadBuffer::SetAttributes()
+{
+    int* locs = rlGetShaderLocsDefault();
+    rlSetVertexAttribute(locs[RL_SHADER_LOC_VERTEX_POSITION], 2, RL_FLOAT, false, sizeof(QuadVertex), offsetof(QuadVertex, x));
+    rlEnableVertexAttribute(locs[RL_SHADER_LOC_VERTEX_POSITION]);
+    rlSetVertexAttribute(locs[RL_SHADER_LOC_VERTEX_TEXCOORD01], 2, RL_FLOAT, false, sizeof(QuadVertex), offsetof(QuadVertex, u));
+    rlEnableVertexAttribute(locs[RL_SHADER_LOC_VERTEX_TEXCOORD01]);
+    rlSetVertexAttribute(locs[RL_SHADER_LOC_VERTEX_COLOR], 4, RL_UNSIGNED_BYTE, true, sizeof(QuadVertex), offsetof(QuadVertex, color));
+    rlEnableVertexAttribute(locs[RL_SHADER_LOC_VERTEX_COLOR]);
+}
+
+void QuadBuffer::Draw(unsigned int textureId)
+{
+    int count = (int)vertices.size();
+    if (count == 0) return;
+
+    if (count > capacity) Allocate(count);
+    if (vbo == 0)
+    {
+        DrawImmediate(textureId);
+        return;
+    }
+    rlUpdateVertexBuffer(vbo, vertices.data(), count * (int)sizeof(QuadVertex), 0);
+
+    // Lo que haya pendiente en el batch de rlgl se dibuja antes, para
+    // respetar el orden
+    rlDrawRenderBatchActive();
+
+    int* locs = rlGetShaderLocsDefault();
+    float white[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+    int textureSlot = 0;
+    rlEnableShader(rlGetShaderIdDefault());
+    rlSetUniformMatrix(locs[RL_SHADER_LOC_MATRIX_MVP], MatrixMultiply(rlGetMatrixModelview(), rlGetMatrixProjection()));
+    rlSetUniform(locs[RL_SHADER_LOC_COLOR_DIFFUSE], white, RL_SHADER_UNIFORM_VEC4, 1);
+    rlSetUniform(locs[RL_SHADER_LOC_MAP_DIFFUSE], &textureSlot, RL_SHADER_UNIFORM_INT, 1);
+    rlActiveTextureSlot(0);
+    rlEnableTexture(textureId);
+
+    if (!rlEnableVertexArray(vao))
+    {
+        rlEnableVertexBuffer(vbo);
+        SetAttributes();
+    }
+    rlDrawVertexArray(0, count);
+    rlDisableVertexArray();
+    rlDisableVertexBuffer();
+
+    rlDisableTexture();
+    rlDisableShader();
+}
+
+// OpenGL 1.1: los mismos triangulos por el batch de rlgl
+void QuadBuffer::DrawImmediate(unsigned int textureId)
+{
+    rlSetTexture(textureId);
+    rlBegin(RL_TRIANGLES);
+    for (size_t i = 0; i < vertices.size(); i++)
+    {
+        if (i % 6 == 0) rlCheckRenderBatchLimit(6);
+        const QuadVertex& v = vertices[i];
+        rlColor4ub(v.color.r, v.color.g, v.color.b, v.color.a);
+        rlTexCoord2f(v.u, v.v);
+        rlVertex2f(v.x, v.y);
+    }
+    rlEnd();
+    rlSetTexture(0);
+}
+
+void QuadBuffer::Unload()
+{
+    if (vao != 0) rlUnloadVertexArray(vao);
+    if (vbo != 0) rlUnloadVertexBuffer(vbo);
+    vao = 0;
+    vbo = 0;
+    capacity = 0;
+}
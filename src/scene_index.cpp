@@ -0,0 +1,409 @@
+#include "scene_index.h"
+#include "raymath.h"
+#include "rlgl.h"
+#include <algorithm>
+#include <math.h>
+
+#define BVH_LEAF_SIZE 4
+
+// -----------------------------------------------------------------------------
+// SceneModel
+// -----------------------------------------------------------------------------
+bool LoadSceneModel(SceneModel* sceneModel, const char* fileName)
+{
+    return InitSceneModel(sceneModel, LoadModel(fileName));
+}
+
+bool InitSceneModel(SceneModel* sceneModel, Model model)
+{
+    sceneModel->model = model;
+    RefreshSceneModelBounds(sceneModel);
+
+    sceneModel->lods.assign(model.meshCount, MeshLods{});
+    for (int i = 0; i < model.meshCount; i++)
+    {
+        sceneModel->lods[i].levels[0] = model.meshes[i];
+        sceneModel->lods[i].levelCount = 1;
+        LodBuilder::getInstance()->Request(sceneModel, &sceneModel->lods[i]);
+    }
+
+    return model.meshCount > 0;
+}
+
+// Caja alineada a los ejes que contiene la caja transformada por la matriz
+static BoundingBox TransformBoxMatrix(const BoundingBox& box, Matrix matrix)
+{
+    BoundingBox result = { 0 };
+    for (int i = 0; i < 8; i++)
+    {
+        Vector3 corner = { (i & 1) ? box.max.x : box.min.x, (i & 2) ? box.max.y : box.min.y, (i & 4) ? box.max.z : box.min.z };
+        corner = Vector3Transform(corner, matrix);
+        if (i == 0) result = BoundingBox{ corner, corner };
+        else
+        {
+            result.min = Vector3Min(result.min, corner);
+            result.max = Vector3Max(result.max, corner);
+        }
+    }
+    return result;
+}
+
+void RefreshSceneModelBounds(SceneModel* sceneModel)
+{
+    const Model& model = sceneModel->model;
+    sceneModel->meshBounds.resize(model.meshCount);
+    sceneModel->bounds = BoundingBox{ { 0, 0, 0 }, { 0, 0, 0 } };
+
+    for (int i = 0; i < model.meshCount; i++)
+    {
+        // Con la transform propia del modelo, que DrawMesh aplica antes que la instancia
+        BoundingBox box = TransformBoxMatrix(GetMeshBoundingBox(model.meshes[i]), model.transform);
+        sceneModel->meshBounds[i] = box;
+        if (i == 0) sceneModel->bounds = box;
+        else
+        {
+            sceneModel->bounds.min = Vector3Min(sceneModel->bounds.min, box.min);
+            sceneModel->bounds.max = Vector3Max(sceneModel->bounds.max, box.max);
+        }
+    }
+}
+
+void UnloadSceneModel(SceneModel* sceneModel)
+{
+    LodBuilder::getInstance()->Cancel(sceneModel);
+    for (size_t i = 0; i < sceneModel->lods.size(); i++)
+        for (int level = 1; level < sceneModel->lods[i].levelCount; level++) UnloadMesh(sceneModel->lods[i].levels[level]);
+    sceneModel->lods.clear();
+
+    UnloadModel(sceneModel->model);
+    sceneModel->model = Model{ 0 };
+    sceneModel->meshBounds.clear();
+}
+
+// -----------------------------------------------------------------------------
+// Frustum: 6 planos con la normal hacia dentro, construidos a partir de la
+// geometria de la camara (no depende de la convencion de matrices)
+// -----------------------------------------------------------------------------
+typedef struct {
+    Vector3 normal;
+    float d;
+} Plane;
+
+typedef struct {
+    Plane planes[6];
+} Frustum;
+
+enum { CULL_OUTSIDE, CULL_INTERSECT, CULL_INSIDE };
+
+static Plane MakePlane(Vector3 normal, Vector3 point)
+{
+    normal = Vector3Normalize(normal);
+    return Plane{ normal, -Vector3DotProduct(normal, point) };
+}
+
+static Frustum BuildFrustum(const Camera3D& camera, float aspect)
+{
+    Vector3 forward = Vector3Normalize(Vector3Subtract(camera.target, camera.position));
+    Vector3 right = Vector3Normalize(Vector3CrossProduct(forward, camera.up));
+    Vector3 up = Vector3CrossProduct(right, forward);
+
+    float nearDist = (float)rlGetCullDistanceNear();
+    float farDist = (float)rlGetCullDistanceFar();
+
+    Frustum f;
+    f.planes[0] = MakePlane(forward, Vector3Add(camera.position, Vector3Scale(forward, nearDist)));
+    f.planes[1] = MakePlane(Vector3Negate(forward), Vector3Add(camera.position, Vector3Scale(forward, farDist)));
+
+    if (camera.projection == CAMERA_PERSPECTIVE)
+    {
+        float halfV = tanf(camera.fovy * 0.5f * DEG2RAD);
+        float halfH = halfV * aspect;
+        f.planes[2] = MakePlane(Vector3Add(Vector3Scale(forward, halfH), right), camera.position);        // Izquierda
+        f.planes[3] = MakePlane(Vector3Subtract(Vector3Scale(forward, halfH), right), camera.position);   // Derecha
+        f.planes[4] = MakePlane(Vector3Add(Vector3Scale(forward, halfV), up), camera.position);           // Abajo
+        f.planes[5] = MakePlane(Vector3Subtract(Vector3Scale(forward, halfV), up), camera.position);      // Arriba
+    }
+    else
+    {
+        // En ortografica fovy es la altura visible
+        float halfV = camera.fovy * 0.5f;
+        float halfH = halfV * aspect;
+        f.planes[2] = MakePlane(right, Vector3Subtract(camera.position, Vector3Scale(right, halfH)));
+        f.planes[3] = MakePlane(Vector3Negate(right), Vector3Add(camera.position, Vector3Scale(right, halfH)));
+        f.planes[4] = MakePlane(up, Vector3Subtract(camera.position, Vector3Scale(up, halfV)));
+        f.planes[5] = MakePlane(Vector3Negate(up), Vector3Add(camera.position, Vector3Scale(up, halfV)));
+    }
+
+    return f;
+}
+
+static int TestBox(const Frustum& f, const BoundingBox& box)
+{
+    int result = CULL_INSIDE;
+    for (int i = 0; i < 6; i++)
+    {
+        const Plane& p = f.planes[i];
+
+        // Vertice mas alejado en la direccion de la normal (p-vertex) y el opuesto (n-vertex)
+        Vector3 pv = { p.normal.x >= 0 ? box.max.x : box.min.x, p.normal.y >= 0 ? box.max.y : box.min.y, p.normal.z >= 0 ? box.max.z : box.min.z };
+        Vector3 nv = { p.normal.x >= 0 ? box.min.x : box.max.x, p.normal.y >= 0 ? box.min.y : box.max.y, p.normal.z >= 0 ? box.min.z : box.max.z };
+
+        if (Vector3DotProduct(p.normal, pv) + p.d < 0) return CULL_OUTSIDE;
+        if (Vector3DotProduct(p.normal, nv) + p.d < 0) result = CULL_INTERSECT;
+    }
+    return result;
+}
+
+static float BoxDistanceSqr(const BoundingBox& box, Vector3 point)
+{
+    Vector3 closest = Vector3Clamp(point, box.min, box.max);
+    return Vector3DistanceSqr(closest, point);
+}
+
+static BoundingBox TransformBox(const BoundingBox& box, Vector3 position, float scale)
+{
+    BoundingBox result;
+    result.min = Vector3Add(Vector3Scale(box.min, scale), position);
+    result.max = Vector3Add(Vector3Scale(box.max, scale), position);
+    return result;
+}
+
+static BoundingBox MergeBox(const BoundingBox& a, const BoundingBox& b)
+{
+    return BoundingBox{ Vector3Min(a.min, b.min), Vector3Max(a.max, b.max) };
+}
+
+// -----------------------------------------------------------------------------
+// Gestion de instancias
+// -----------------------------------------------------------------------------
+int SceneIndex::AddInstance(SceneModel* source, Vector3 position, float scale)
+{
+    SceneInstance instance = { source, position, scale, true, 0 };
+
+    int id;
+    if (!freeIds.empty())
+    {
+        id = freeIds.back();
+        freeIds.pop_back();
+        instances[id] = instance;
+    }
+    else
+    {
+        id = (int)instances.size();
+        instances.push_back(instance);
+        worldBounds.push_back(BoundingBox{ 0 });
+    }
+
+    dirty = true;
+    return id;
+}
+
+void SceneIndex::RemoveInstance(int id)
+{
+    if (id < 0 || id >= (int)instances.size() || !instances[id].enabled) return;
+    instances[id].enabled = false;
+    instances[id].source = NULL;
+    freeIds.push_back(id);
+    dirty = true;
+}
+
+void SceneIndex::SetInstancePosition(int id, Vector3 position)
+{
+    if (id < 0 || id >= (int)instances.size()) return;
+    instances[id].position = position;
+    dirty = true;
+}
+
+// -----------------------------------------------------------------------------
+// Construccion del BVH: particion por la mediana del centroide en el eje mas
+// largo. Se reconstruye entera cuando algo cambia; las escenas son estaticas
+// la mayor parte del tiempo
+// -----------------------------------------------------------------------------
+void SceneIndex::Rebuild()
+{
+    order.clear();
+    nodes.clear();
+
+    for (int i = 0; i < (int)instances.size(); i++)
+    {
+        const SceneInstance& inst = instances[i];
+        if (!inst.enabled || inst.source == NULL) continue;
+        worldBounds[i] = TransformBox(inst.source->bounds, inst.position, inst.scale);
+        order.push_back(i);
+    }
+
+    if (!order.empty())
+    {
+        nodes.reserve(2 * order.size() / BVH_LEAF_SIZE + 1);
+        BuildNode(0, (int)order.size());
+    }
+
+    dirty = false;
+}
+
+int SceneIndex::BuildNode(int first, int count)
+{
+    int index = (int)nodes.size();
+    nodes.push_back(BvhNode{});
+
+    BoundingBox box = worldBounds[order[first]];
+    BoundingBox centroids = { Vector3Scale(Vector3Add(box.min, box.max), 0.5f), Vector3Scale(Vector3Add(box.min, box.max), 0.5f) };
+    for (int i = first + 1; i < first + count; i++)
+    {
+        const BoundingBox& b = worldBounds[order[i]];
+        Vector3 c = Vector3Scale(Vector3Add(b.min, b.max), 0.5f);
+        box = MergeBox(box, b);
+        centroids.min = Vector3Min(centroids.min, c);
+        centroids.max = Vector3Max(centroids.max, c);
+    }
+
+    if (count <= BVH_LEAF_SIZE)
+    {
+        nodes[index] = BvhNode{ box, -1, -1, first, count };
+        return index;
+    }
+
+    Vector3 extent = Vector3Subtract(centroids.max, centroids.min);
+    int axis = 0;
+    if (extent.y > extent.x) axis = 1;
+    if (extent.z > (axis == 0 ? extent.x : extent.y)) axis = 2;
+
+    auto centroid = [this, axis](int id) {
+        const BoundingBox& b = worldBounds[id];
+        if (axis == 0) return b.min.x + b.max.x;
+        if (axis == 1) return b.min.y + b.max.y;
+        return b.min.z + b.max.z;
+    };
+
+    int half = count / 2;
+    std::nth_element(order.begin() + first, order.begin() + first + half, order.begin() + first + count,
+        [&centroid](int a, int b) { return centroid(a) < centroid(b); });
+
+    int left = BuildNode(first, half);
+    int right = BuildNode(first + half, count - half);
+    nodes[index] = BvhNode{ box, left, right, first, count };
+    return index;
+}
+
+// -----------------------------------------------------------------------------
+// Culling
+// -----------------------------------------------------------------------------
+void SceneIndex::Cull(const Camera3D& camera, float aspect, std::vector<SceneDrawItem>& out)
+{
+    if (dirty) Rebuild();
+
+    out.clear();
+    stats = SceneStats{ 0 };
+    stats.instances = (int)order.size();
+    if (nodes.empty()) return;
+
+    Frustum frustum = BuildFrustum(camera, aspect);
+    float maxDistSqr = maxDrawDistance * maxDrawDistance;
+    float viewHalfHeight = (camera.projection == CAMERA_PERSPECTIVE) ? tanf(camera.fovy * 0.5f * DEG2RAD) : camera.fovy * 0.5f;
+
+    // Recorrido iterativo; cada entrada guarda si el padre ya estaba entero dentro
+    int stack[64][2];
+    int top = 0;
+    stack[top][0] = 0;
+    stack[top][1] = CULL_INTERSECT;
+    top++;
+
+    while (top > 0)
+    {
+        top--;
+        const BvhNode& node = nodes[stack[top][0]];
+        int state = stack[top][1];
+        stats.nodesVisited++;
+
+        if (maxDrawDistance > 0 && BoxDistanceSqr(node.box, camera.position) > maxDistSqr) state = CULL_OUTSIDE;
+        else if (state != CULL_INSIDE) state = TestBox(frustum, node.box);
+
+        if (state == CULL_OUTSIDE)
+        {
+            for (int i = node.first; i < node.first + node.count; i++)
+                stats.culledMeshes += instances[order[i]].source->model.meshCount;
+            continue;
+        }
+
+        if (node.left >= 0)
+        {
+            stack[top][0] = node.right; stack[top][1] = state; top++;
+            stack[top][0] = node.left;  stack[top][1] = state; top++;
+            continue;
+        }
+
+        for (int i = node.first; i < node.first + node.count; i++)
+        {
+            SceneInstance& inst = instances[order[i]];
+            const SceneModel* src = inst.source;
+
+            // La distancia se comprueba siempre: que la hoja este dentro del
+            // frustum no dice nada de lo lejos que quedan sus instancias
+            int instState = state;
+            if (maxDrawDistance > 0 && BoxDistanceSqr(worldBounds[order[i]], camera.position) > maxDistSqr) instState = CULL_OUTSIDE;
+            else if (instState != CULL_INSIDE) instState = TestBox(frustum, worldBounds[order[i]]);
+
+            if (instState == CULL_OUTSIDE)
+            {
+                stats.culledMeshes += src->model.meshCount;
+                continue;
+            }
+
+            // Igual que DrawModelEx: escala, traslacion y despues la transform propia del modelo
+            Matrix transform = MatrixMultiply(MatrixScale(inst.scale, inst.scale, inst.scale),
+                MatrixTranslate(inst.position.x, inst.position.y, inst.position.z));
+            transform = MatrixMultiply(src->model.transform, transform);
+
+            // Tamano proyectado de la esfera envolvente respecto a la semialtura de la vista
+            const BoundingBox& box = worldBounds[order[i]];
+            Vector3 center = Vector3Scale(Vector3Add(box.min, box.max), 0.5f);
+            float radius = Vector3Distance(box.min, box.max) * 0.5f;
+            float screenSize;
+            if (camera.projection == CAMERA_PERSPECTIVE)
+            {
+                float dist = Vector3Distance(center, camera.position);
+                screenSize = (dist > radius) ? radius / (dist * viewHalfHeight) : 1.0f;
+            }
+            else screenSize = radius / viewHalfHeight;
+            inst.lodLevel = SelectLodLevel(screenSize, inst.lodLevel, MAX_LOD_LEVELS);
+
+            bool anyVisible = false;
+            for (int m = 0; m < src->model.meshCount; m++)
+            {
+                if (instState != CULL_INSIDE && src->model.meshCount > 1 &&
+                    TestBox(frustum, TransformBox(src->meshBounds[m], inst.position, inst.scale)) == CULL_OUTSIDE)
+                {
+                    stats.culledMeshes++;
+                    continue;
+                }
+
+                // Si el nivel pedido aun no esta generado se usa el mas grueso ya
+                // disponible, el mas cercano al pedido (los niveles se generan en orden)
+                const MeshLods& lods = src->lods[m];
+                int level = inst.lodLevel < lods.levelCount ? inst.lodLevel : lods.levelCount - 1;
+                const Mesh* mesh = (level == 0) ? &src->model.meshes[m] : &lods.levels[level];
+
+                out.push_back(SceneDrawItem{ mesh, &src->model.materials[src->model.meshMaterial[m]], transform });
+                stats.visibleMeshes++;
+                stats.triangles += mesh->triangleCount;
+                stats.lodMeshes[level]++;
+                anyVisible = true;
+            }
+            if (anyVisible) stats.visibleInstances++;
+        }
+    }
+}
+
+void SceneIndex::Draw(const Camera3D& camera, float aspect)
+{
+    Cull(camera, aspect, drawItems);
+    DrawSceneItems(drawItems);
+}
+
+void DrawSceneItems(const std::vector<SceneDrawItem>& items)
+{
+    for (size_t i = 0; i < items.size(); i++)
+    {
+        DrawMesh(*items[i].mesh, *items[i].material, items[i].transform);
+    }
+}
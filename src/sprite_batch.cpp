@@ -0,0 +1,206 @@
+#include "sprite_batch.h"
+#include <algorithm>
+#include <string.h>
+
+// -----------------------------------------------------------------------------
+// SpriteAtlas
+// -----------------------------------------------------------------------------
+int SpriteAtlas::AddImage(const char* fileName)
+{
+    Image image = LoadImage(fileName);
+    if (image.data == NULL) return -1;
+    return AddImage(image);
+}
+
+int SpriteAtlas::AddImage(Image image)
+{
+    ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    images.push_back(image);
+    sprites.push_back(Sprite{ -1, { 0, 0, (float)image.width, (float)image.height } });
+    return (int)sprites.size() - 1;
+}
+
+bool SpriteAtlas::SkylineFit(const PackPage& page, int index, int width, int height, int* y)
+{
+    int x = page.skyline[index].x;
+    if (x + width > page.size) return false;
+
+    // La altura del hueco es la maxima de los segmentos que cubre el rectangulo
+    int top = 0;
+    int remaining = width;
+    for (int i = index; remaining > 0; i++)
+    {
+        if (i >= (int)page.skyline.size()) return false;
+        top = std::max(top, page.skyline[i].y);
+        if (top + height > page.size) return false;
+        remaining -= page.skyline[i].width;
+    }
+    *y = top;
+    return true;
+}
+
+bool SpriteAtlas::SkylineInsert(PackPage& page, int width, int height, int* x, int* y)
+{
+    int bestIndex = -1;
+    int bestBottom = 0;
+    int bestWidth = 0;
+
+    for (int i = 0; i < (int)page.skyline.size(); i++)
+    {
+        int top;
+        if (!SkylineFit(page, i, width, height, &top)) continue;
+        int bottom = top + height;
+        if (bestIndex < 0 || bottom < bestBottom || (bottom == bestBottom && page.skyline[i].width < bestWidth))
+        {
+            bestIndex = i;
+            bestBottom = bottom;
+            bestWidth = page.skyline[i].width;
+            *x = page.skyline[i].x;
+            *y = top;
+        }
+    }
+    if (bestIndex < 0) return false;
+
+    page.skyline.insert(page.skyline.begin() + bestIndex, SkylineNode{ *x, *y + height, width });
+
+    // Recorta los segmentos que quedan debajo del nuevo
+    for (size_t i = bestIndex + 1; i < page.skyline.size(); i++)
+    {
+        SkylineNode& prev = page.skyline[i - 1];
+        SkylineNode& node = page.skyline[i];
+        if (node.x >= prev.x + prev.width) break;
+
+        int shrink = prev.x + prev.width - node.x;
+        node.x += shrink;
+        node.width -= shrink;
+        if (node.width > 0) break;
+        page.skyline.erase(page.skyline.begin() + i);
+        i--;
+    }
+
+    // Une segmentos contiguos a la misma altura
+    for (size_t i = 0; i + 1 < page.skyline.size(); i++)
+    {
+        if (page.skyline[i].y == page.skyline[i + 1].y)
+        {
+            page.skyline[i].width += page.skyline[i + 1].width;
+            page.skyline.erase(page.skyline.begin() + i + 1);
+            i--;
+        }
+    }
+    return true;
+}
+
+bool SpriteAtlas::Build()
+{
+    std::vector<int> order(images.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = (int)i;
+    std::sort(order.begin(), order.end(), [this](int a, int b) {
+        if (images[a].height != images[b].height) return images[a].height > images[b].height;
+        return images[a].width > images[b].width;
+    });
+
+    std::vector<PackPage> packPages;
+    for (size_t n = 0; n < order.size(); n++)
+    {
+        int id = order[n];
+        const Image& image = images[id];
+        int width = image.width + ATLAS_PADDING;
+        int height = image.height + ATLAS_PADDING;
+
+        int x = 0, y = 0;
+        int page = -1;
+        for (size_t p = 0; p < packPages.size() && page < 0; p++)
+            if (SkylineInsert(packPages[p], width, height, &x, &y)) page = (int)p;
+
+        if (page < 0)
+        {
+            // Las imagenes mas grandes que una pagina tienen la suya propia
+            PackPage newPage;
+            newPage.size = std::max(ATLAS_PAGE_SIZE, std::max(width, height));
+            newPage.skyline.push_back(SkylineNode{ 0, 0, newPage.size });
+            newPage.image = GenImageColor(newPage.size, newPage.size, BLANK);
+            packPages.push_back(newPage);
+            page = (int)packPages.size() - 1;
+            SkylineInsert(packPages[page], width, height, &x, &y);
+        }
+
+        // Copia directa de filas: ImageDraw mezclaria con el fondo transparente
+        Image& dst = packPages[page].image;
+        for (int row = 0; row < image.height; row++)
+        {
+            memcpy((unsigned char*)dst.data + ((y + row) * dst.width + x) * 4,
+                (unsigned char*)image.data + row * image.width * 4, image.width * 4);
+        }
+
+        sprites[id].page = (int)pages.size() + page;
+        sprites[id].source.x = (float)x;
+        sprites[id].source.y = (float)y;
+        UnloadImage(image);
+    }
+    images.clear();
+
+    bool ok = true;
+    for (size_t p = 0; p < packPages.size(); p++)
+    {
+        Texture2D texture = LoadTextureFromImage(packPages[p].image);
+        UnloadImage(packPages[p].image);
+        if (texture.id == 0) ok = false;
+        pages.push_back(texture);
+    }
+    return ok;
+}
+
+void SpriteAtlas::Unload()
+{
+    for (size_t i = 0; i < images.size(); i++) UnloadImage(images[i]);
+    for (size_t i = 0; i < pages.size(); i++) UnloadTexture(pages[i]);
+    images.clear();
+    pages.clear();
+    sprites.clear();
+}
+
+// -----------------------------------------------------------------------------
+// SpriteBatch
+// -----------------------------------------------------------------------------
+void SpriteBatch::Begin(const SpriteAtlas* spriteAtlas)
+{
+    atlas = spriteAtlas;
+    if ((int)pageBuffers.size() < atlas->GetPageCount()) pageBuffers.resize(atlas->GetPageCount());
+    for (size_t i = 0; i < pageBuffers.size(); i++) pageBuffers[i].Clear();
+    spriteCount = 0;
+    pageSubmits = 0;
+}
+
+void SpriteBatch::Draw(int sprite, Vector2 position, float scale, Color tint)
+{
+    const Sprite& s = atlas->GetSprite(sprite);
+    if (s.page < 0) return;
+
+    Texture2D page = atlas->GetPage(s.page);
+    float u0 = s.source.x / page.width;
+    float v0 = s.source.y / page.height;
+    float u1 = (s.source.x + s.source.width) / page.width;
+    float v1 = (s.source.y + s.source.height) / page.height;
+    float x1 = position.x + s.source.width * scale;
+    float y1 = position.y + s.source.height * scale;
+
+    WriteQuad(pageBuffers[s.page].AddQuads(1), position.x, position.y, x1, y1, u0, v0, u1, v1, tint);
+    spriteCount++;
+}
+
+void SpriteBatch::End()
+{
+    for (int p = 0; p < atlas->GetPageCount(); p++)
+    {
+        if (pageBuffers[p].GetQuadCount() == 0) continue;
+        pageBuffers[p].Draw(atlas->GetPage(p).id);
+        pageSubmits++;
+    }
+}
+
+void SpriteBatch::Unload()
+{
+    for (size_t i = 0; i < pageBuffers.size(); i++) pageBuffers[i].Unload();
+    pageBuffers.clear();
+}
@@ -0,0 +1,715 @@
+#include "world_streaming.h"
+#include "..\build\build_files\GameObject.h"
+#include "raymath.h"
+#include <algorithm>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Suavizado de la velocidad de la camara (por frame)
+#define STREAM_VELOCITY_SMOOTHING 0.2f
+// Los LODs que genera el LodBuilder anaden hasta un 85% a los meshes originales
+#define STREAM_LOD_OVERHEAD 1.85f
+// Vertices por cara que acepta el parser de OBJ
+#define OBJ_MAX_FACE_VERTICES 64
+// Valores que sustituyen a los de config.ini que no son validos
+#define STREAM_MIN_CHUNK_SIZE 1.0f
+#define STREAM_DEFAULT_CHUNK_SIZE 64.0f
+#define STREAM_MAX_RADIUS 32
+#define STREAM_DEFAULT_PREFETCH 1.5f
+#define STREAM_DEFAULT_BUDGET_MB 256
+#define STREAM_DEFAULT_UPLOAD_MS 2.0f
+// Coordenada de chunk maxima (en valor absoluto), muy lejos del limite del int
+#define STREAM_MAX_COORD (1 << 20)
+
+// -----------------------------------------------------------------------------
+// Archivos de chunk
+// -----------------------------------------------------------------------------
+bool ParseChunkFile(const char* fileName, std::vector<ChunkModelEntry>* models, std::vector<ChunkObjectEntry>* objects)
+{
+    FILE* file = fopen(fileName, "r");
+    if (file == NULL) return false;
+
+    char line[512];
+    char path[256];
+    char texture[256];
+    int lineNumber = 0;
+    while (fgets(line, sizeof(line), file))
+    {
+        lineNumber++;
+        if (line[0] == '#' || line[0] == '\n' || line[0] == '\r' || line[0] == '\0') continue;
+
+        ChunkModelEntry model;
+        if (sscanf(line, "model %255s %255s %f %f %f %f", path, texture,
+            &model.position.x, &model.position.y, &model.position.z, &model.scale) == 6)
+        {
+            model.model = path;
+            model.texture = strcmp(texture, "-") == 0 ? "" : texture;
+            models->push_back(model);
+            continue;
+        }
+
+        ChunkObjectEntry object;
+        if (sscanf(line, "object %255s %f %f %f %f", path,
+            &object.position.x, &object.position.y, &object.size.x, &object.size.y) == 5)
+        {
+            object.name = path;
+            objects->push_back(object);
+            continue;
+        }
+
+        TraceLog(LOG_WARNING, "WORLD: %s:%d: linea no reconocida", fileName, lineNumber);
+    }
+
+    fclose(file);
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// OBJ
+// -----------------------------------------------------------------------------
+typedef struct {
+    int position;
+    int texcoord;               // -1 si la cara no lo trae
+    int normal;
+} ObjCorner;
+
+// Indices desde 1; los negativos cuentan desde el final. -1 si no es valido
+static int ObjIndex(long index, size_t count)
+{
+    if (index > 0 && index <= (long)count) return (int)index - 1;
+    if (index < 0 && -index <= (long)count) return (int)((long)count + index);
+    return -1;
+}
+
+// Vertices de una cara: v, v/vt, v//vn o v/vt/vn. Devuelve cuantos lee, 0 si
+// alguno no es valido
+static int ParseObjFace(const char* cursor, size_t positions, size_t texcoords, size_t normals, ObjCorner* corners)
+{
+    int count = 0;
+    while (count < OBJ_MAX_FACE_VERTICES)
+    {
+        char* end;
+        long index = strtol(cursor, &end, 10);
+        if (end == cursor) break;
+        cursor = end;
+
+        ObjCorner corner = { ObjIndex(index, positions), -1, -1 };
+        if (corner.position < 0) return 0;
+        if (*cursor == '/')
+        {
+            cursor++;
+            index = strtol(cursor, &end, 10);
+            if (end != cursor) corner.texcoord = ObjIndex(index, texcoords);
+            cursor = end;
+            if (*cursor == '/')
+            {
+                cursor++;
+                index = strtol(cursor, &end, 10);
+                if (end != cursor) corner.normal = ObjIndex(index, normals);
+                cursor = end;
+            }
+        }
+        corners[count++] = corner;
+    }
+    return count;
+}
+
+bool ParseObjMesh(const char* fileName, Mesh* mesh)
+{
+    *mesh = Mesh{ 0 };
+    FILE* file = fopen(fileName, "r");
+    if (file == NULL)
+    {
+        TraceLog(LOG_WARNING, "WORLD: No se pudo abrir el modelo %s", fileName);
+        return false;
+    }
+
+    std::vector<Vector3> positions;
+    std::vector<Vector2> texcoords;
+    std::vector<Vector3> normals;
+    std::vector<float> vertexData;      // Por vertice: posicion, uv, normal
+    ObjCorner corners[OBJ_MAX_FACE_VERTICES];
+    int badFaces = 0;
+
+    char line[1024];
+    while (fgets(line, sizeof(line), file))
+    {
+        if (line[0] == 'v' && line[1] == ' ')
+        {
+            Vector3 position = { 0 };
+            sscanf(line + 2, "%f %f %f", &position.x, &position.y, &position.z);
+            positions.push_back(position);
+        }
+        else if (line[0] == 'v' && line[1] == 't' && line[2] == ' ')
+        {
+            // Con el origen arriba, igual que el cargador de raylib
+            Vector2 texcoord = { 0 };
+            sscanf(line + 3, "%f %f", &texcoord.x, &texcoord.y);
+            texcoord.y = 1.0f - texcoord.y;
+            texcoords.push_back(texcoord);
+        }
+        else if (line[0] == 'v' && line[1] == 'n' && line[2] == ' ')
+        {
+            Vector3 normal = { 0 };
+            sscanf(line + 3, "%f %f %f", &normal.x, &normal.y, &normal.z);
+            normals.push_back(normal);
+        }
+        else if (line[0] == 'f' && line[1] == ' ')
+        {
+            int count = ParseObjFace(line + 2, positions.size(), texcoords.size(), normals.size(), corners);
+            if (count < 3)
+            {
+                badFaces++;
+                continue;
+            }
+
+            // Poligonos en abanico; la normal plana cubre los vertices sin vn
+            for (int k = 1; k + 1 < count; k++)
+            {
+                const ObjCorner* triangle[3] = { &corners[0], &corners[k], &corners[k + 1] };
+                Vector3 a = positions[triangle[0]->position];
+                Vector3 b = positions[triangle[1]->position];
+                Vector3 c = positions[triangle[2]->position];
+                Vector3 flat = Vector3Normalize(Vector3CrossProduct(Vector3Subtract(b, a), Vector3Subtract(c, a)));
+                for (int j = 0; j < 3; j++)
+                {
+                    Vector3 position = positions[triangle[j]->position];
+                    Vector2 texcoord = triangle[j]->texcoord >= 0 ? texcoords[triangle[j]->texcoord] : Vector2{ 0, 0 };
+                    Vector3 normal = triangle[j]->normal >= 0 ? normals[triangle[j]->normal] : flat;
+                    float vertex[8] = { position.x, position.y, position.z, texcoord.x, texcoord.y, normal.x, normal.y, normal.z };
+                    vertexData.insert(vertexData.end(), vertex, vertex + 8);
+                }
+            }
+        }
+    }
+    fclose(file);
+
+    if (badFaces > 0) TraceLog(LOG_WARNING, "WORLD: %s: %d caras no validas", fileName, badFaces);
+    int vertexCount = (int)(vertexData.size() / 8);
+    if (vertexCount == 0)
+    {
+        TraceLog(LOG_WARNING, "WORLD: %s no tiene triangulos", fileName);
+        return false;
+    }
+
+    mesh->vertexCount = vertexCount;
+    mesh->triangleCount = vertexCount / 3;
+    mesh->vertices = (float*)MemAlloc(vertexCount * 3 * sizeof(float));
+    mesh->texcoords = (float*)MemAlloc(vertexCount * 2 * sizeof(float));
+    mesh->normals = (float*)MemAlloc(vertexCount * 3 * sizeof(float));
+    for (int i = 0; i < vertexCount; i++)
+    {
+        const float* vertex = &vertexData[i * 8];
+        memcpy(&mesh->vertices[i * 3], vertex, 3 * sizeof(float));
+        memcpy(&mesh->texcoords[i * 2], vertex + 3, 2 * sizeof(float));
+        memcpy(&mesh->normals[i * 3], vertex + 5, 3 * sizeof(float));
+    }
+    return true;
+}
+
+static size_t EstimateMeshBytes(const Mesh& mesh)
+{
+    size_t perVertex = (3 + 3 + 2) * sizeof(float);
+    if (mesh.colors != NULL) perVertex += 4;
+    if (mesh.tangents != NULL) perVertex += 4 * sizeof(float);
+    size_t bytes = (size_t)mesh.vertexCount * perVertex;
+    if (mesh.indices != NULL) bytes += (size_t)mesh.triangleCount * 3 * sizeof(unsigned short);
+    return bytes;
+}
+
+// Chunk que contiene la posicion, acotado para que una posicion enorme, inf o
+// NaN no desborde la conversion a int
+static int ChunkCoord(float position, float chunkSize)
+{
+    float coord = floorf(position / chunkSize);
+    if (!(coord > -STREAM_MAX_COORD)) return -STREAM_MAX_COORD;     // Incluye NaN
+    if (coord > STREAM_MAX_COORD) return STREAM_MAX_COORD;
+    return (int)coord;
+}
+
+// -----------------------------------------------------------------------------
+// Hilo de carga: lee los archivos de chunk, parsea los OBJ y decodifica las
+// imagenes. Solo usa funciones de raylib sin estado compartido (LoadImage,
+// MemAlloc, TraceLog); nada de TextFormat ni de OpenGL
+// -----------------------------------------------------------------------------
+void WorldStreamer::Init(const char* dir, const WorldStreamConfig& streamConfig, SceneIndex* sceneIndex)
+{
+    directory = dir;
+    config = streamConfig;
+    if (!isfinite(config.chunkSize) || config.chunkSize < STREAM_MIN_CHUNK_SIZE)
+    {
+        TraceLog(LOG_WARNING, "WORLD: chunksize %f no valido, se usa %.0f", config.chunkSize, STREAM_DEFAULT_CHUNK_SIZE);
+        config.chunkSize = STREAM_DEFAULT_CHUNK_SIZE;
+    }
+    if (config.loadRadius < 0 || config.loadRadius > STREAM_MAX_RADIUS)
+    {
+        int radius = config.loadRadius < 0 ? 0 : STREAM_MAX_RADIUS;
+        TraceLog(LOG_WARNING, "WORLD: streamradius %d fuera de [0, %d], se usa %d", config.loadRadius, STREAM_MAX_RADIUS, radius);
+        config.loadRadius = radius;
+    }
+    if (!isfinite(config.prefetchSeconds) || config.prefetchSeconds < 0)
+    {
+        TraceLog(LOG_WARNING, "WORLD: prediccion de %f s no valida, se usa %.1f", config.prefetchSeconds, STREAM_DEFAULT_PREFETCH);
+        config.prefetchSeconds = STREAM_DEFAULT_PREFETCH;
+    }
+    if (config.memoryBudgetMB <= 0)
+    {
+        TraceLog(LOG_WARNING, "WORLD: streammb %d no valido, se usa %d", config.memoryBudgetMB, STREAM_DEFAULT_BUDGET_MB);
+        config.memoryBudgetMB = STREAM_DEFAULT_BUDGET_MB;
+    }
+    if (!isfinite(config.uploadBudgetMs) || config.uploadBudgetMs <= 0)
+    {
+        TraceLog(LOG_WARNING, "WORLD: presupuesto de subida de %f ms no valido, se usa %.1f", config.uploadBudgetMs, STREAM_DEFAULT_UPLOAD_MS);
+        config.uploadBudgetMs = STREAM_DEFAULT_UPLOAD_MS;
+    }
+    scene = sceneIndex;
+    stats = WorldStreamStats{ 0 };
+    stats.budgetBytes = (size_t)config.memoryBudgetMB * 1024 * 1024;
+    hasLastPosition = false;
+    velocity = Vector3{ 0, 0, 0 };
+    memoryLimited = false;
+
+    stopping = false;
+    worker = std::thread(&WorldStreamer::WorkerLoop, this);
+}
+
+void WorldStreamer::WorkerLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+        chunkReady.wait(lock, [this] { return stopping || !pending.empty(); });
+        if (stopping) return;
+
+        StreamJob job = pending.front();
+        pending.pop_front();
+        lock.unlock();
+
+        if (job.chunk != NULL) LoadChunkData(job.chunk);
+        else LoadAssetData(job.asset);
+
+        lock.lock();
+        parsed.push_back(job);
+    }
+}
+
+void WorldStreamer::LoadChunkData(StreamChunk* chunk)
+{
+    // Un chunk sin archivo es terreno vacio: queda residente sin contenido
+    char fileName[512];
+    snprintf(fileName, sizeof(fileName), "%s/chunk_%d_%d.txt", directory.c_str(), chunk->x, chunk->z);
+    ParseChunkFile(fileName, &chunk->models, &chunk->objects);
+}
+
+void WorldStreamer::LoadAssetData(StreamAsset* asset)
+{
+    // Si falla el mesh queda vacio y el asset se marca como fallido al subirlo
+    if (!ParseObjMesh(asset->modelFile.c_str(), &asset->mesh)) return;
+    if (!asset->textureFile.empty()) asset->image = LoadImage(asset->textureFile.c_str());
+}
+
+void WorldStreamer::FreeAssetData(StreamAsset* asset)
+{
+    // Solo los arrays que reserva ParseObjMesh; aun no hay buffers de GPU
+    MemFree(asset->mesh.vertices);
+    MemFree(asset->mesh.texcoords);
+    MemFree(asset->mesh.normals);
+    if (asset->image.data != NULL) UnloadImage(asset->image);
+    asset->mesh = Mesh{ 0 };
+    asset->image = Image{ 0 };
+}
+
+// Descarta un chunk o un asset que esta en manos del hilo de carga. Si el
+// hilo aun no lo ha empezado se quita de pending y se borra; si ya lo tiene,
+// se marca y se borra al volver en parsed (CollectParsed)
+void WorldStreamer::CancelJob(StreamJob job)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::deque<StreamJob>::iterator it = pending.begin();
+        while (it != pending.end() && (it->chunk != job.chunk || it->asset != job.asset)) ++it;
+        if (it == pending.end())
+        {
+            if (job.chunk != NULL) job.chunk->cancelled = true;
+            else job.asset->cancelled = true;
+            return;
+        }
+        pending.erase(it);
+    }
+    delete job.chunk;
+    delete job.asset;
+}
+
+// -----------------------------------------------------------------------------
+// Cache de assets compartidos. Solo la usa el hilo principal; el hilo de carga
+// recibe cada asset nuevo como un trabajo y no vuelve a tocarlo al devolverlo
+// -----------------------------------------------------------------------------
+WorldStreamer::StreamAsset* WorldStreamer::AcquireAsset(const ChunkModelEntry& entry)
+{
+    std::string key = AssetKey(entry);
+    std::unordered_map<std::string, StreamAsset*>::iterator it = assets.find(key);
+    if (it != assets.end())
+    {
+        it->second->refCount++;
+        return it->second;
+    }
+
+    StreamAsset* asset = new StreamAsset();
+    asset->key = key;
+    asset->modelFile = entry.model;
+    asset->textureFile = entry.texture;
+    asset->state = ASSET_QUEUED;
+    asset->cancelled = false;
+    asset->refCount = 1;
+    assets[key] = asset;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    pending.push_back(StreamJob{ NULL, asset });
+    chunkReady.notify_one();
+    return asset;
+}
+
+// Parte del hilo principal: solo la subida a la GPU
+void WorldStreamer::UploadAsset(StreamAsset* asset)
+{
+    if (asset->mesh.vertexCount == 0)
+    {
+        FreeAssetData(asset);
+        asset->state = ASSET_FAILED;
+        return;
+    }
+
+    // El Model se queda con los buffers del mesh
+    UploadMesh(&asset->mesh, false);
+    InitSceneModel(&asset->model, LoadModelFromMesh(asset->mesh));
+    asset->mesh = Mesh{ 0 };
+
+    asset->texture = Texture2D{ 0 };
+    if (asset->image.data != NULL)
+    {
+        asset->texture = LoadTextureFromImage(asset->image);
+        UnloadImage(asset->image);
+        asset->image = Image{ 0 };
+    }
+    if (asset->texture.id != 0) asset->model.model.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = asset->texture;
+
+    size_t meshBytes = 0;
+    for (int i = 0; i < asset->model.model.meshCount; i++) meshBytes += EstimateMeshBytes(asset->model.model.meshes[i]);
+    asset->bytes = (size_t)(meshBytes * STREAM_LOD_OVERHEAD);
+    if (asset->texture.id != 0)
+        asset->bytes += GetPixelDataSize(asset->texture.width, asset->texture.height, asset->texture.format);
+
+    stats.residentBytes += asset->bytes;
+    asset->state = ASSET_READY;
+}
+
+void WorldStreamer::ReleaseAsset(StreamAsset* asset)
+{
+    if (--asset->refCount > 0) return;
+    assets.erase(asset->key);
+
+    switch (asset->state)
+    {
+    case ASSET_QUEUED:
+        CancelJob(StreamJob{ NULL, asset });
+        return;
+    case ASSET_PARSED:
+        uploading.erase(std::find(uploading.begin(), uploading.end(), asset));
+        FreeAssetData(asset);
+        break;
+    case ASSET_READY:
+        stats.residentBytes -= asset->bytes;
+        retired.push_back(asset);
+        return;
+    case ASSET_FAILED:
+        break;
+    }
+    delete asset;
+}
+
+void WorldStreamer::ReleaseRetired()
+{
+    for (size_t i = 0; i < retired.size(); i++)
+    {
+        UnloadSceneModel(&retired[i]->model);
+        if (retired[i]->texture.id != 0) UnloadTexture(retired[i]->texture);
+        delete retired[i];
+    }
+    retired.clear();
+}
+
+// -----------------------------------------------------------------------------
+// Chunks
+// -----------------------------------------------------------------------------
+void WorldStreamer::RequestChunk(int x, int z)
+{
+    StreamChunk* chunk = new StreamChunk();
+    chunk->x = x;
+    chunk->z = z;
+    chunk->state = CHUNK_QUEUED;
+    chunk->cancelled = false;
+    chunk->nextModel = 0;
+    chunk->nextObject = 0;
+    chunks[ChunkKey(x, z)] = chunk;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    pending.push_back(StreamJob{ chunk, NULL });
+    chunkReady.notify_one();
+}
+
+void WorldStreamer::UnloadChunk(StreamChunk* chunk)
+{
+    chunks.erase(ChunkKey(chunk->x, chunk->z));
+
+    if (chunk->state == CHUNK_QUEUED)
+    {
+        CancelJob(StreamJob{ chunk, NULL });
+        return;
+    }
+
+    if (chunk->state == CHUNK_LOADING)
+        finalizing.erase(std::find(finalizing.begin(), finalizing.end(), chunk));
+
+    for (size_t i = 0; i < chunk->instances.size(); i++) scene->RemoveInstance(chunk->instances[i]);
+    // GameObject::Spawn los reserva con new y solo los conoce el chunk
+    for (size_t i = 0; i < chunk->spawned.size(); i++) delete chunk->spawned[i];
+    for (size_t i = 0; i < chunk->assets.size(); i++) ReleaseAsset(chunk->assets[i]);
+    delete chunk;
+}
+
+// Resultados del hilo de carga. Un chunk parseado reserva ya sus assets para
+// que el hilo los vaya preparando mientras se dan de alta los anteriores
+void WorldStreamer::CollectParsed()
+{
+    std::deque<StreamJob> arrived;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        arrived.swap(parsed);
+    }
+    for (size_t i = 0; i < arrived.size(); i++)
+    {
+        StreamAsset* asset = arrived[i].asset;
+        if (asset != NULL)
+        {
+            if (asset->cancelled)
+            {
+                FreeAssetData(asset);
+                delete asset;
+                continue;
+            }
+            asset->state = ASSET_PARSED;
+            uploading.push_back(asset);
+            continue;
+        }
+
+        StreamChunk* chunk = arrived[i].chunk;
+        if (chunk->cancelled)
+        {
+            delete chunk;
+            continue;
+        }
+        chunk->state = CHUNK_LOADING;
+        for (size_t m = 0; m < chunk->models.size(); m++) chunk->assets.push_back(AcquireAsset(chunk->models[m]));
+        finalizing.push_back(chunk);
+    }
+}
+
+// Da de alta una entrada del chunk; false si el siguiente modelo aun no esta
+// en la GPU. Al terminar el chunk pasa a residente
+bool WorldStreamer::FinalizeStep(StreamChunk* chunk)
+{
+    if (chunk->nextModel < chunk->models.size())
+    {
+        StreamAsset* asset = chunk->assets[chunk->nextModel];
+        if (asset->state == ASSET_QUEUED || asset->state == ASSET_PARSED) return false;
+        const ChunkModelEntry& entry = chunk->models[chunk->nextModel++];
+        if (asset->state == ASSET_READY)
+            chunk->instances.push_back(scene->AddInstance(&asset->model, entry.position, entry.scale));
+    }
+    else if (chunk->nextObject < chunk->objects.size())
+    {
+        const ChunkObjectEntry& entry = chunk->objects[chunk->nextObject++];
+        chunk->spawned.push_back(GameObject::Spawn(entry.position, entry.size, entry.name));
+    }
+
+    if (chunk->nextModel >= chunk->models.size() && chunk->nextObject >= chunk->objects.size())
+    {
+        chunk->state = CHUNK_RESIDENT;
+        finalizing.erase(std::find(finalizing.begin(), finalizing.end(), chunk));
+    }
+    return true;
+}
+
+// Bytes que se liberan al descargar el chunk: los de los assets subidos que
+// no comparte con ningun otro
+size_t WorldStreamer::ReleasableBytes(const StreamChunk* chunk) const
+{
+    std::unordered_map<const StreamAsset*, int> uses;
+    for (size_t i = 0; i < chunk->assets.size(); i++) uses[chunk->assets[i]]++;
+
+    size_t bytes = 0;
+    for (std::unordered_map<const StreamAsset*, int>::iterator it = uses.begin(); it != uses.end(); ++it)
+        if (it->first->state == ASSET_READY && it->first->refCount == it->second) bytes += it->first->bytes;
+    return bytes;
+}
+
+float WorldStreamer::ChunkDistance(const StreamChunk* chunk, Vector3 position) const
+{
+    float centerX = (chunk->x + 0.5f) * config.chunkSize;
+    float centerZ = (chunk->z + 0.5f) * config.chunkSize;
+    return sqrtf((centerX - position.x) * (centerX - position.x) + (centerZ - position.z) * (centerZ - position.z));
+}
+
+void WorldStreamer::Update(Vector3 cameraPosition, float dt)
+{
+    if (scene == NULL) return;
+    double start = GetTime();
+
+    // Velocidad suavizada: la prediccion adelanta la carga en la direccion
+    // del movimiento
+    if (hasLastPosition && dt > 0.0f)
+    {
+        Vector3 current = Vector3Scale(Vector3Subtract(cameraPosition, lastPosition), 1.0f / dt);
+        velocity = Vector3Lerp(velocity, current, STREAM_VELOCITY_SMOOTHING);
+        // Un dt diminuto puede dar inf, y un inf se quedaria para siempre en el suavizado
+        if (!isfinite(velocity.x) || !isfinite(velocity.z)) velocity = Vector3{ 0, 0, 0 };
+    }
+    lastPosition = cameraPosition;
+    hasLastPosition = true;
+    Vector3 predicted = Vector3Add(cameraPosition, Vector3Scale(velocity, config.prefetchSeconds));
+
+    int cameraX = ChunkCoord(cameraPosition.x, config.chunkSize);
+    int cameraZ = ChunkCoord(cameraPosition.z, config.chunkSize);
+    int predictedX = ChunkCoord(predicted.x, config.chunkSize);
+    int predictedZ = ChunkCoord(predicted.z, config.chunkSize);
+    if (cameraX != lastCameraX || cameraZ != lastCameraZ) memoryLimited = false;
+    lastCameraX = cameraX;
+    lastCameraZ = cameraZ;
+
+    int radius = config.loadRadius;
+    auto nearCamera = [&](int x, int z, int r) { return abs(x - cameraX) <= r && abs(z - cameraZ) <= r; };
+    auto nearPrediction = [&](int x, int z) { return abs(x - predictedX) <= radius && abs(z - predictedZ) <= radius; };
+
+    // Descarga, con un chunk de histeresis para no oscilar en los bordes
+    std::vector<StreamChunk*> outside;
+    for (std::unordered_map<long long, StreamChunk*>::iterator it = chunks.begin(); it != chunks.end(); ++it)
+    {
+        StreamChunk* chunk = it->second;
+        if (!nearCamera(chunk->x, chunk->z, radius + 1) && !nearPrediction(chunk->x, chunk->z)) outside.push_back(chunk);
+    }
+    for (size_t i = 0; i < outside.size(); i++) UnloadChunk(outside[i]);
+
+    CollectParsed();
+
+    // Subidas a la GPU y altas en la escena dentro del presupuesto; al menos
+    // una por frame para que la carga siempre avance. Un chunk que espera a
+    // un asset del hilo de carga no bloquea a los siguientes
+    double deadline = start + config.uploadBudgetMs / 1000.0;
+    bool worked = false;
+    while (!worked || GetTime() < deadline)
+    {
+        if (!uploading.empty())
+        {
+            StreamAsset* asset = uploading.front();
+            uploading.pop_front();
+            UploadAsset(asset);
+            worked = true;
+            continue;
+        }
+
+        bool advanced = false;
+        for (size_t i = 0; i < finalizing.size() && !advanced; i++) advanced = FinalizeStep(finalizing[i]);
+        if (!advanced) break;
+        worked = true;
+    }
+
+    // Tope de memoria: fuera los chunks mas lejanos, nunca el de la camara.
+    // Solo cuentan los que liberan algo al descargarse: un chunk cuyos assets
+    // comparten otros no baja la memoria. Hasta que la camara cambie de chunk
+    // no se piden mas, para no descargar y volver a cargar los mismos cada frame
+    while (stats.residentBytes > stats.budgetBytes)
+    {
+        StreamChunk* farthest = NULL;
+        float farthestDistance = -1.0f;
+        for (std::unordered_map<long long, StreamChunk*>::iterator it = chunks.begin(); it != chunks.end(); ++it)
+        {
+            StreamChunk* chunk = it->second;
+            if (chunk->state == CHUNK_QUEUED || (chunk->x == cameraX && chunk->z == cameraZ)) continue;
+            if (ReleasableBytes(chunk) == 0) continue;
+            float distance = ChunkDistance(chunk, cameraPosition);
+            if (distance > farthestDistance)
+            {
+                farthest = chunk;
+                farthestDistance = distance;
+            }
+        }
+        if (farthest == NULL) break;
+        UnloadChunk(farthest);
+        stats.evictions++;
+        memoryLimited = true;
+    }
+    if (stats.residentBytes > stats.budgetBytes) memoryLimited = true;
+
+    // Peticiones nuevas alrededor de la camara y de la prediccion, primero
+    // las mas cercanas a la prediccion
+    typedef struct {
+        float distance;
+        int x;
+        int z;
+    } ChunkRequest;
+    std::vector<ChunkRequest> requests;
+    int centers[2][2] = { { cameraX, cameraZ }, { predictedX, predictedZ } };
+    for (int c = 0; c < 2; c++)
+    {
+        for (int z = centers[c][1] - radius; z <= centers[c][1] + radius; z++)
+        {
+            for (int x = centers[c][0] - radius; x <= centers[c][0] + radius; x++)
+            {
+                if (chunks.find(ChunkKey(x, z)) != chunks.end()) continue;
+                if (c == 1 && nearCamera(x, z, radius)) continue;       // Ya anadido
+                if (memoryLimited && !(x == cameraX && z == cameraZ)) continue;
+                float dx = (x + 0.5f) * config.chunkSize - predicted.x;
+                float dz = (z + 0.5f) * config.chunkSize - predicted.z;
+                requests.push_back(ChunkRequest{ dx * dx + dz * dz, x, z });
+            }
+        }
+    }
+    std::sort(requests.begin(), requests.end(), [](const ChunkRequest& a, const ChunkRequest& b) { return a.distance < b.distance; });
+    for (size_t i = 0; i < requests.size(); i++) RequestChunk(requests[i].x, requests[i].z);
+
+    // Estadisticas
+    stats.residentChunks = 0;
+    stats.loadingChunks = 0;
+    stats.instances = 0;
+    stats.objects = 0;
+    for (std::unordered_map<long long, StreamChunk*>::iterator it = chunks.begin(); it != chunks.end(); ++it)
+    {
+        const StreamChunk* chunk = it->second;
+        if (chunk->state == CHUNK_RESIDENT) stats.residentChunks++;
+        else stats.loadingChunks++;
+        stats.instances += (int)chunk->instances.size();
+        stats.objects += (int)chunk->spawned.size();
+    }
+    stats.assets = (int)assets.size();
+    stats.updateMs = (float)((GetTime() - start) * 1000.0);
+}
+
+void WorldStreamer::Shutdown()
+{
+    if (!worker.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        chunkReady.notify_all();
+    }
+    worker.join();
+
+    // Con el hilo parado lo que quede en pending se cancela sin esperar: al
+    // descargar todos los chunks se sueltan todos los assets
+    CollectParsed();
+    while (!chunks.empty()) UnloadChunk(chunks.begin()->second);
+    ReleaseRetired();
+    scene = NULL;
+}